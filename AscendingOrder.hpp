@@ -4,6 +4,7 @@
 
 #include "MyContainer.hpp"
 #include "Iterator.hpp"
+#include "SortEngine.hpp"
 #include <algorithm>
 #include <numeric>
 
@@ -19,10 +20,14 @@ namespace container
      * Example: Container [5, 2, 8, 1] -> Ascending iteration: [1, 2, 5, 8]
      * 
      * @tparam T The type of elements in the container
+     * @tparam Allocator Allocator of the container's storage
      */
-    template <typename T>
-    class MyContainer<T>::AscendingOrder : public Iterator<T>
+    template <typename T, typename Allocator>
+    class MyContainer<T, Allocator>::AscendingOrder : public Iterator<T, Allocator>
     {
+    private:
+        MyContainer<T, Allocator>& owner;  ///< Container whose maintained sorted permutation is reused
+
     public:
         /**
          * @brief Constructor that creates an ascending order iterator
@@ -30,31 +35,46 @@ namespace container
          * 
          * Automatically calls prepareIndices() to set up the sorted traversal order.
          */
-        AscendingOrder(MyContainer<T> &c) : Iterator<T>(c.getT())
+        AscendingOrder(MyContainer<T, Allocator> &c) : Iterator<T, Allocator>(c.getT(), c.indexPool()), owner(c)
         {
+            static_assert(sort_engine::is_less_comparable_v<T>,
+                          "AscendingOrder requires operator< on T - pass a key projection instead");
             prepareIndices();
         }
 
+        /**
+         * @brief Constructor that orders elements by a projected key
+         * @param c Reference to the MyContainer to iterate over
+         * @param proj Projection that extracts the sort key (e.g. &Trade::price)
+         * 
+         * Keys are extracted once into a contiguous column and that column is
+         * sorted, so the element type's own operator< is never used.
+         */
+        template <typename Proj>
+        AscendingOrder(MyContainer<T, Allocator> &c, Proj proj) : Iterator<T, Allocator>(c.getT(), c.indexPool()), owner(c)
+        {
+            auto keys = sort_engine::extractKeys(this->original_container, proj);
+            this->indices.resize(this->original_container.size());
+            std::iota(this->indices.begin(), this->indices.end(), 0);
+            sort_engine::sortByKeys(keys, this->indices.begin(), this->indices.end(), std::less<>(), c.sortKernel());
+        }
+
     protected:
         /**
          * @brief Prepares the indices for ascending order traversal
          * 
-         * This method:
-         * 1. Creates indices [0, 1, 2, ..., size-1]
-         * 2. Sorts these indices based on the actual element values
-         * 3. Results in indices that point to elements in ascending value order
+         * Copies the container's maintained ascending permutation
+         * (MyContainer::sortedIndices()), which only sorts elements added since
+         * the previous sorted read and merges them in.
          * 
          * The sorting uses element values but rearranges indices, so the
          * original container remains unchanged.
          */
         void prepareIndices() override
         {
-            this->indices.resize(this->original_container.size());
-            std::iota(this->indices.begin(), this->indices.end(), 0);
-            std::sort(this->indices.begin(), this->indices.end(), 
-                [&](size_t i, size_t j) {
-                    return this->original_container[i] < this->original_container[j];
-                });
+            if constexpr (sort_engine::is_less_comparable_v<T>) {
+                this->indices = owner.sortedIndices();
+            }
         }
     };
 }
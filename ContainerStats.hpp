@@ -0,0 +1,162 @@
+// galashkena1@gmail.com
+#ifndef _CONTAINER_STATS_HPP_
+#define _CONTAINER_STATS_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace container
+{
+    /**
+     * @brief Point-in-time copy of a container's performance counters
+     *
+     * visit() hands every counter to a callback as (name, value), which is the
+     * easiest way to forward them to a metrics system:
+     *   c.stats().visit([&](const char* name, uint64_t value) { gauge(prefix + name).set(value); });
+     */
+    struct StatsSnapshot {
+        uint64_t sorts = 0;                   ///< Sorts run (full, tail-only or by projection)
+        uint64_t index_allocations = 0;       ///< Index buffers allocated or grown
+        uint64_t index_bytes = 0;             ///< Bytes requested by those allocations
+        uint64_t iterator_constructions = 0;  ///< Orders created through the factory methods
+        uint64_t prepare_ns_total = 0;        ///< Total time spent constructing orders (prepareIndices)
+        uint64_t prepare_ns_max = 0;          ///< Longest single order construction
+
+        template <typename F>
+        void visit(F f) const {
+            f("sorts", sorts);
+            f("index_allocations", index_allocations);
+            f("index_bytes", index_bytes);
+            f("iterator_constructions", iterator_constructions);
+            f("prepare_ns_total", prepare_ns_total);
+            f("prepare_ns_max", prepare_ns_max);
+        }
+    };
+
+    /**
+     * @brief Live counters of one container
+     *
+     * Every update is a single relaxed atomic operation: the counters are
+     * statistics, not synchronization, so they may be read while other threads
+     * update them and a snapshot may mix values from slightly different moments.
+     */
+    class ContainerStats
+    {
+    private:
+        std::atomic<uint64_t> sorts{0};
+        std::atomic<uint64_t> index_allocations{0};
+        std::atomic<uint64_t> index_bytes{0};
+        std::atomic<uint64_t> iterator_constructions{0};
+        std::atomic<uint64_t> prepare_ns_total{0};
+        std::atomic<uint64_t> prepare_ns_max{0};
+
+    public:
+        void recordSort() {
+            sorts.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void recordIndexAllocation(size_t bytes) {
+            index_allocations.fetch_add(1, std::memory_order_relaxed);
+            index_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        void recordConstruction(uint64_t ns) {
+            iterator_constructions.fetch_add(1, std::memory_order_relaxed);
+            prepare_ns_total.fetch_add(ns, std::memory_order_relaxed);
+            uint64_t longest = prepare_ns_max.load(std::memory_order_relaxed);
+            while (ns > longest && !prepare_ns_max.compare_exchange_weak(longest, ns, std::memory_order_relaxed)) {
+            }
+        }
+
+        StatsSnapshot snapshot() const {
+            StatsSnapshot s;
+            s.sorts = sorts.load(std::memory_order_relaxed);
+            s.index_allocations = index_allocations.load(std::memory_order_relaxed);
+            s.index_bytes = index_bytes.load(std::memory_order_relaxed);
+            s.iterator_constructions = iterator_constructions.load(std::memory_order_relaxed);
+            s.prepare_ns_total = prepare_ns_total.load(std::memory_order_relaxed);
+            s.prepare_ns_max = prepare_ns_max.load(std::memory_order_relaxed);
+            return s;
+        }
+
+        void reset() {
+            sorts.store(0, std::memory_order_relaxed);
+            index_allocations.store(0, std::memory_order_relaxed);
+            index_bytes.store(0, std::memory_order_relaxed);
+            iterator_constructions.store(0, std::memory_order_relaxed);
+            prepare_ns_total.store(0, std::memory_order_relaxed);
+            prepare_ns_max.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @brief Optional counters owned by a container (null while stats are disabled)
+     *
+     * Copying a container starts the copy with fresh counters if the source
+     * had stats enabled, so containers stay copyable and never share counters.
+     */
+    class StatsSlot
+    {
+    private:
+        std::unique_ptr<ContainerStats> counters;
+
+    public:
+        StatsSlot() = default;
+        StatsSlot(const StatsSlot& other) : counters(other.counters ? std::make_unique<ContainerStats>() : nullptr) {}
+        StatsSlot(StatsSlot&&) noexcept = default;
+
+        StatsSlot& operator=(const StatsSlot& other) {
+            if (this != &other) {
+                counters = other.counters ? std::make_unique<ContainerStats>() : nullptr;
+            }
+            return *this;
+        }
+
+        StatsSlot& operator=(StatsSlot&&) noexcept = default;
+
+        ContainerStats* get() const { return counters.get(); }
+
+        void enable() {
+            if (!counters) counters = std::make_unique<ContainerStats>();
+        }
+
+        void disable() { counters.reset(); }
+    };
+
+    /**
+     * @brief Times one order construction and records it with its index buffer
+     *
+     * Does nothing (not even reading the clock) when stats are disabled.
+     */
+    class StatsScope
+    {
+    private:
+        ContainerStats* stats;
+        size_t index_bytes;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        /**
+         * @param s Counters to update, or nullptr
+         * @param bytes Size of the index buffer the new order allocates (0 for none)
+         */
+        StatsScope(ContainerStats* s, size_t bytes) : stats(s), index_bytes(bytes) {
+            if (stats) start = std::chrono::steady_clock::now();
+        }
+
+        StatsScope(const StatsScope&) = delete;
+        StatsScope& operator=(const StatsScope&) = delete;
+
+        ~StatsScope() {
+            if (!stats) return;
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            if (index_bytes > 0) stats->recordIndexAllocation(index_bytes);
+            stats->recordConstruction(static_cast<uint64_t>(ns.count()));
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,46 @@
+// galashkena1@gmail.com
+#ifndef _CPU_FEATURES_HPP_
+#define _CPU_FEATURES_HPP_
+
+namespace container
+{
+    /**
+     * @brief Runtime detection of the SIMD instruction sets used by the kernels
+     * 
+     * Kernels that use AVX2 or AVX-512 are compiled with per-function target
+     * attributes and only called after these checks pass, so the project
+     * itself builds without -mavx2 and still runs on older CPUs.
+     */
+    namespace cpu
+    {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CONTAINER_X86_SIMD 1
+#endif
+
+        /**
+         * @brief True if the CPU supports AVX2
+         */
+        inline bool hasAvx2() {
+#ifdef CONTAINER_X86_SIMD
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * @brief True if the CPU supports the AVX-512 foundation instructions
+         */
+        inline bool hasAvx512() {
+#ifdef CONTAINER_X86_SIMD
+            static const bool supported = __builtin_cpu_supports("avx512f");
+            return supported;
+#else
+            return false;
+#endif
+        }
+    }
+}
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "MyContainer.hpp"
 #include "Iterator.hpp"
+#include "SortEngine.hpp"
 #include <algorithm>
 #include <numeric>
 
@@ -19,10 +20,14 @@ namespace container
      * Example: Container [5, 2, 8, 1] -> Descending iteration: [8, 5, 2, 1]
      * 
      * @tparam T The type of elements in the container
+     * @tparam Allocator Allocator of the container's storage
      */
-    template <typename T>
-    class MyContainer<T>::DescendingOrder : public Iterator<T>
+    template <typename T, typename Allocator>
+    class MyContainer<T, Allocator>::DescendingOrder : public Iterator<T, Allocator>
     {
+    private:
+        MyContainer<T, Allocator>& owner;  ///< Container whose maintained sorted permutation is reused
+
     public:
         /**
          * @brief Constructor that creates a descending order iterator
@@ -30,30 +35,43 @@ namespace container
          * 
          * Automatically calls prepareIndices() to set up the reverse-sorted traversal order.
          */
-        DescendingOrder(MyContainer<T> &c) :  Iterator<T>(c.getT())
+        DescendingOrder(MyContainer<T, Allocator> &c) : Iterator<T, Allocator>(c.getT(), c.indexPool()), owner(c)
         {
+            static_assert(sort_engine::is_less_comparable_v<T>,
+                          "DescendingOrder requires operator< on T - pass a key projection instead");
             prepareIndices();
         }
 
+        /**
+         * @brief Constructor that orders elements by a projected key, largest first
+         * @param c Reference to the MyContainer to iterate over
+         * @param proj Projection that extracts the sort key (e.g. &Trade::price)
+         * 
+         * Keys are extracted once into a contiguous column and that column is
+         * sorted with the greater-than operator.
+         */
+        template <typename Proj>
+        DescendingOrder(MyContainer<T, Allocator> &c, Proj proj) : Iterator<T, Allocator>(c.getT(), c.indexPool()), owner(c)
+        {
+            auto keys = sort_engine::extractKeys(this->original_container, proj);
+            this->indices.resize(this->original_container.size());
+            std::iota(this->indices.begin(), this->indices.end(), 0);
+            sort_engine::sortByKeys(keys, this->indices.begin(), this->indices.end(), std::greater<>(), c.sortKernel());
+        }
+
     protected:
         /**
          * @brief Prepares the indices for descending order traversal
          * 
-         * This method:
-         * 1. Creates indices [0, 1, 2, ..., size-1]
-         * 2. Sorts these indices based on element values in descending order
-         * 3. Results in indices that point to elements from largest to smallest
-         * 
-         * Uses the greater-than operator (>) to sort in descending order.
+         * Walks the container's maintained ascending permutation
+         * (MyContainer::sortedIndices()) backwards, so no separate sort is needed.
          */
         void prepareIndices() override
         {
-            this->indices.resize(this->original_container.size());
-            std::iota(this->indices.begin(), this->indices.end(), 0);
-            std::sort(this->indices.begin(), this->indices.end(), 
-                [&](size_t i, size_t j) {
-                    return this->original_container[i] > this->original_container[j];
-                });
+            if constexpr (sort_engine::is_less_comparable_v<T>) {
+                const index_vector& sorted = owner.sortedIndices();
+                this->indices.assign(sorted.rbegin(), sorted.rend());
+            }
         }
     };
 }
@@ -0,0 +1,103 @@
+// galashkena1@gmail.com
+#ifndef _GATHER_HPP_
+#define _GATHER_HPP_
+
+#include "CpuFeatures.hpp"
+#include "Parallel.hpp"
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#ifdef CONTAINER_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace container
+{
+    namespace simd
+    {
+        /**
+         * @brief Smallest number of elements a gather thread is given
+         */
+        inline constexpr size_t GATHER_PARALLEL_CHUNK = size_t(1) << 18;
+
+#ifdef CONTAINER_X86_SIMD
+        /**
+         * @brief AVX2 gather of 8-byte elements: dst[k] = src[idx[k]]
+         */
+        __attribute__((target("avx2")))
+        inline void gather64Avx2(const void* src, const size_t* idx, void* dst, size_t n) {
+            const long long* base = static_cast<const long long*>(src);
+            char* out = static_cast<char*>(dst);
+            size_t k = 0;
+            for (; k + 4 <= n; k += 4) {
+                __m256i positions = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + k));
+                __m256i values = _mm256_i64gather_epi64(base, positions, 8);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k * 8), values);
+            }
+            for (; k < n; ++k) {
+                std::memcpy(out + k * 8, base + idx[k], 8);
+            }
+        }
+
+        /**
+         * @brief AVX2 gather of 4-byte elements: dst[k] = src[idx[k]]
+         */
+        __attribute__((target("avx2")))
+        inline void gather32Avx2(const void* src, const size_t* idx, void* dst, size_t n) {
+            const int* base = static_cast<const int*>(src);
+            char* out = static_cast<char*>(dst);
+            size_t k = 0;
+            for (; k + 4 <= n; k += 4) {
+                __m256i positions = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + k));
+                __m128i values = _mm256_i64gather_epi32(base, positions, 4);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k * 4), values);
+            }
+            for (; k < n; ++k) {
+                std::memcpy(out + k * 4, base + idx[k], 4);
+            }
+        }
+#endif
+
+        /**
+         * @brief Single-threaded gather: dst[k] = src[idx[k]] for k in [0, n)
+         * 
+         * Trivially copyable 32/64-bit elements use the AVX2 gather instruction
+         * when the CPU has it; everything else is copied with a scalar loop.
+         */
+        template <typename T>
+        void gatherSerial(const T* src, const size_t* idx, T* dst, size_t n) {
+#ifdef CONTAINER_X86_SIMD
+            if constexpr (std::is_trivially_copyable_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)) {
+                if (cpu::hasAvx2()) {
+                    if constexpr (sizeof(T) == 8) {
+                        gather64Avx2(src, idx, dst, n);
+                    } else {
+                        gather32Avx2(src, idx, dst, n);
+                    }
+                    return;
+                }
+            }
+#endif
+            for (size_t k = 0; k < n; ++k) {
+                dst[k] = src[idx[k]];
+            }
+        }
+
+        /**
+         * @brief Gathers src[idx[k]] into contiguous dst, splitting large inputs across threads
+         * @param src Element storage
+         * @param idx Positions to read, in output order
+         * @param dst Output buffer with room for n elements
+         * @param n Number of elements to gather
+         */
+        template <typename T>
+        void gather(const T* src, const size_t* idx, T* dst, size_t n) {
+            parallel::forChunks(n, GATHER_PARALLEL_CHUNK, [&](size_t, size_t begin, size_t end) {
+                gatherSerial(src, idx + begin, dst + begin, end - begin);
+            });
+        }
+    }
+}
+
+#endif
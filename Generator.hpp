@@ -0,0 +1,128 @@
+// galashkena1@gmail.com
+#ifndef _GENERATOR_HPP_
+#define _GENERATOR_HPP_
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace container
+{
+    /**
+     * @brief Lazily evaluated sequence of references produced by a C++20 coroutine
+     * 
+     * The coroutine body runs only when the consumer advances the iterator, and
+     * each co_yield hands out a reference to an existing element - nothing is
+     * copied and nothing is buffered. Generator is a move-only std::ranges view,
+     * so it composes with adaptors such as std::views::filter or std::views::take.
+     * 
+     * Example: for (int& v : lazy::ascending(c) | std::views::take(3)) { ... }
+     * 
+     * @tparam T The type of the referenced elements (may be const-qualified)
+     */
+    template <typename T>
+    class Generator : public std::ranges::view_base
+    {
+    public:
+        /**
+         * @brief Coroutine promise: remembers the address of the last yielded element
+         */
+        struct promise_type {
+            T* current = nullptr;          ///< Element produced by the latest co_yield
+            std::exception_ptr error;      ///< Exception escaping the coroutine body
+
+            Generator get_return_object() {
+                return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            std::suspend_always yield_value(T& value) noexcept {
+                current = std::addressof(value);
+                return {};
+            }
+            void return_void() noexcept {}
+            void unhandled_exception() { error = std::current_exception(); }
+
+            // Generators only yield; co_await inside the body is not supported
+            template <typename U>
+            std::suspend_never await_transform(U&&) = delete;
+        };
+
+        /**
+         * @brief Single-pass input iterator that resumes the coroutine on increment
+         */
+        class iterator {
+        private:
+            std::coroutine_handle<promise_type> handle;
+
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = std::remove_cv_t<T>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            explicit iterator(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+            T& operator*() const { return *handle.promise().current; }
+
+            iterator& operator++() {
+                handle.resume();
+                rethrowIfFailed(handle);
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+
+            friend bool operator==(const iterator& it, std::default_sentinel_t) {
+                return !it.handle || it.handle.done();
+            }
+        };
+
+        Generator() = default;
+        Generator(const Generator&) = delete;
+        Generator& operator=(const Generator&) = delete;
+        Generator(Generator&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+        Generator& operator=(Generator&& other) noexcept {
+            if (this != &other) {
+                if (handle) handle.destroy();
+                handle = std::exchange(other.handle, {});
+            }
+            return *this;
+        }
+        ~Generator() {
+            if (handle) handle.destroy();
+        }
+
+        /**
+         * @brief Starts the coroutine and returns an iterator to the first element
+         * 
+         * Like any input range, a generator can be iterated only once.
+         */
+        iterator begin() {
+            if (handle) {
+                handle.resume();
+                rethrowIfFailed(handle);
+            }
+            return iterator(handle);
+        }
+
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+
+        explicit Generator(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+        static void rethrowIfFailed(std::coroutine_handle<promise_type> h) {
+            if (h.done() && h.promise().error) {
+                std::rethrow_exception(std::exchange(h.promise().error, nullptr));
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,161 @@
+// galashkena1@gmail.com
+#ifndef _INDEX_POOL_HPP_
+#define _INDEX_POOL_HPP_
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace container
+{
+    /**
+     * @brief Recycled index buffers shared by the orders of one container
+     *
+     * Every order owns an n-element index buffer. Instead of allocating it on
+     * construction and freeing it on destruction, an order borrows a buffer
+     * from its container's pool and hands it back when it dies, so a loop that
+     * keeps re-creating orders over a container of stable size reuses the
+     * same few buffers and makes no heap allocations after the first pass.
+     *
+     * The pool keeps at most MAX_BUFFERS buffers; extra ones returned while it
+     * is full are freed. Buffers are only handed out to orders whose allocator
+     * compares equal to the buffer's (for std::pmr allocators: the same memory
+     * resource). Borrowing and returning lock a mutex, so orders may be
+     * destroyed on a different thread than the one that created them.
+     *
+     * @tparam Allocator Allocator of the index buffers (that of the container, rebound to size_t)
+     */
+    template <typename Allocator = std::allocator<size_t>>
+    class BasicIndexPool
+    {
+    public:
+        /**
+         * @brief Number of idle buffers kept for reuse
+         */
+        static constexpr size_t MAX_BUFFERS = 4;
+
+        using buffer_type = std::vector<size_t, Allocator>;
+
+    private:
+        std::array<std::optional<buffer_type>, MAX_BUFFERS> idle;  ///< Returned buffers, most recent last
+        size_t idle_count = 0;
+        mutable std::mutex mutex;
+
+    public:
+        BasicIndexPool() = default;
+        BasicIndexPool(const BasicIndexPool&) = delete;
+        BasicIndexPool& operator=(const BasicIndexPool&) = delete;
+
+        ~BasicIndexPool() { trim(); }
+
+        /**
+         * @brief Lends an empty index buffer, reusing a returned one when possible
+         * @param allocator Allocator the buffer must allocate with
+         * @return An empty buffer whose capacity is that of the reused buffer (0 if none was idle)
+         */
+        buffer_type acquire(const Allocator& allocator) {
+            std::lock_guard<std::mutex> lock(mutex);
+            while (idle_count > 0) {
+                std::optional<buffer_type>& slot = idle[--idle_count];
+                if (slot->get_allocator() == allocator) {
+                    buffer_type lent(std::move(*slot));
+                    slot.reset();
+                    lent.clear();
+                    return lent;
+                }
+                slot.reset();
+            }
+            return buffer_type(allocator);
+        }
+
+        /**
+         * @brief Takes a buffer back for later orders
+         * @param buffer The buffer; ignored if it never allocated
+         */
+        void release(buffer_type&& buffer) {
+            if (buffer.capacity() == 0) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (idle_count == MAX_BUFFERS) {
+                return;  // the caller's buffer is freed as it goes out of scope
+            }
+            idle[idle_count++].emplace(std::move(buffer));
+        }
+
+        /**
+         * @brief Checks whether the next acquire() can hold n indices without allocating
+         */
+        bool canServe(size_t n) const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return idle_count > 0 && idle[idle_count - 1]->capacity() >= n;
+        }
+
+        /**
+         * @brief Number of buffers waiting to be reused
+         */
+        size_t idleBuffers() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return idle_count;
+        }
+
+        /**
+         * @brief Frees every idle buffer
+         */
+        void trim() {
+            std::lock_guard<std::mutex> lock(mutex);
+            while (idle_count > 0) {
+                idle[--idle_count].reset();
+            }
+        }
+    };
+
+    /**
+     * @brief Index pool of containers using the default allocator
+     */
+    using IndexPool = BasicIndexPool<>;
+
+    /**
+     * @brief Pool owned by a container, created by the first order that needs it
+     *
+     * Orders hold a shared_ptr to the pool, so a buffer returned after its
+     * container is gone is simply freed. Copies start without a pool and
+     * assignment keeps the target's, so containers never share buffers.
+     *
+     * @tparam Allocator Allocator of the index buffers
+     */
+    template <typename Allocator = std::allocator<size_t>>
+    class IndexPoolSlot
+    {
+    private:
+        std::shared_ptr<BasicIndexPool<Allocator>> pool;
+
+    public:
+        IndexPoolSlot() = default;
+        IndexPoolSlot(const IndexPoolSlot&) {}
+        IndexPoolSlot(IndexPoolSlot&&) noexcept = default;
+
+        IndexPoolSlot& operator=(const IndexPoolSlot&) { return *this; }
+
+        IndexPoolSlot& operator=(IndexPoolSlot&&) noexcept = default;
+
+        /**
+         * @brief The pool, allocating it on first use
+         */
+        const std::shared_ptr<BasicIndexPool<Allocator>>& get() {
+            if (!pool) pool = std::make_shared<BasicIndexPool<Allocator>>();
+            return pool;
+        }
+
+        /**
+         * @brief The pool if one was created, otherwise nullptr
+         */
+        BasicIndexPool<Allocator>* peek() const { return pool.get(); }
+    };
+}
+
+#endif
@@ -3,8 +3,14 @@
 #define _ITERATOR_HPP_
 
 #include <vector>
+#include <memory>
 #include <iostream>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
+#include "Gather.hpp"
+#include "IndexPool.hpp"
+#include "Trace.hpp"
 
 namespace container
 {
@@ -24,6 +30,19 @@ namespace container
         InvalidIteratorException() : IteratorException("Iterator is in invalid state") {}
     };
 
+    /**
+     * @brief Hints the CPU to start loading the cache line holding address
+     * 
+     * Compiles to a prefetch instruction on GCC/Clang and to nothing elsewhere.
+     */
+    inline void prefetchRead(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address, 0, 3);
+#else
+        (void)address;
+#endif
+    }
+
     /**
      * @brief Abstract base class for all iterator types
      * 
@@ -31,31 +50,78 @@ namespace container
      * It manages indices that determine the order of traversal and provides
      * a custom iterator interface for range-based for loops.
      * 
+     * The index buffer uses the container's allocator (rebound to size_t), so
+     * orders over a pmr::MyContainer placed in an arena never touch the global
+     * heap. When the container has an index pool the buffer is borrowed from it
+     * and handed back by the destructor.
+     * 
      * @tparam T The type of elements in the container
+     * @tparam Allocator Allocator of the container's storage (default: std::allocator<T>)
      */
-    template <typename T>
+    template <typename T, typename Allocator = std::allocator<T>>
     class Iterator
     {
+    public:
+        using storage_type = std::vector<T, Allocator>;
+        using index_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<size_t>;
+        using index_vector = std::vector<size_t, index_allocator_type>;
+        using index_pool_type = BasicIndexPool<index_allocator_type>;
+
     protected:
-        std::vector<T>& original_container;  
-        std::vector<size_t> indices;        
+        storage_type& original_container;  
+        index_vector indices;        
+        std::shared_ptr<index_pool_type> index_pool;  ///< Where indices is returned on destruction (may be null)
 
     public:
+        /**
+         * @brief Default number of elements for_each() prefetches ahead (0: prefetching is opt-in)
+         *
+         * Measured on random int data, prefetching at distance 16 gave no gain for
+         * large orders and was slower for cache-resident ones, so it is off unless
+         * a caller passes a distance tuned for its machine.
+         */
+        static constexpr size_t DEFAULT_PREFETCH_DISTANCE = 0;
+
         /**
          * @brief Constructor that creates an iterator for the given container
          * @param container Reference to the container to iterate over
+         * @param pool Pool to borrow the index buffer from (nullptr allocates a new one)
          * @throws InvalidIteratorException if the container is empty
+         * 
+         * The index buffer uses the container's allocator.
          */
-        Iterator(std::vector<T>& container) : original_container(container) {
+        Iterator(storage_type& container, std::shared_ptr<index_pool_type> pool = nullptr) 
+            : original_container(container), indices(borrow(pool.get(), index_allocator_type(container.get_allocator()))),
+              index_pool(std::move(pool)) {
             if (container.empty()) {
                 throw InvalidIteratorException();
             }
         }
+
+        /**
+         * @brief Copy constructor - the copy's index buffer uses the source's allocator
+         * @param other Order to copy
+         */
+        Iterator(const Iterator& other) 
+            : original_container(other.original_container),
+              indices(borrow(other.index_pool.get(), other.indices.get_allocator())),
+              index_pool(other.index_pool) {
+            indices = other.indices;
+        }
+
+        /**
+         * @brief Move constructor
+         */
+        Iterator(Iterator&&) = default;
         
         /**
-         * @brief Virtual destructor for proper inheritance
+         * @brief Virtual destructor for proper inheritance - returns the index buffer to its pool
          */
-        virtual ~Iterator() = default;
+        virtual ~Iterator() {
+            if (index_pool) {
+                index_pool->release(std::move(indices));
+            }
+        }
         
         /**
          * @brief Custom iterator class that implements the actual iteration logic
@@ -65,10 +131,14 @@ namespace container
          */
         class custom_iterator {
         private:
-            std::vector<T>& container;           ///< Reference to the data container
-            typename std::vector<size_t>::iterator idx_it;      ///< Current position in indices
-            typename std::vector<size_t>::iterator indices_begin; ///< Begin iterator for bounds checking
-            typename std::vector<size_t>::iterator indices_end;   ///< End iterator for bounds checking
+            storage_type& container;           ///< Reference to the data container
+            typename index_vector::iterator idx_it;      ///< Current position in indices
+            typename index_vector::iterator indices_begin; ///< Begin iterator for bounds checking
+            typename index_vector::iterator indices_end;   ///< End iterator for bounds checking
+#ifdef CONTAINER_TRACING
+            bool traced = false;       ///< True if begin() created this iterator
+            uint64_t trace_start = 0;  ///< When begin() created this iterator
+#endif
             
         public:
             /**
@@ -78,10 +148,10 @@ namespace container
              * @param begin_it Begin iterator for bounds checking
              * @param end_it End iterator for bounds checking
              */
-            custom_iterator(std::vector<T>& cont, 
-                          typename std::vector<size_t>::iterator it,
-                          typename std::vector<size_t>::iterator begin_it,
-                          typename std::vector<size_t>::iterator end_it) 
+            custom_iterator(storage_type& cont, 
+                          typename index_vector::iterator it,
+                          typename index_vector::iterator begin_it,
+                          typename index_vector::iterator end_it) 
                 : container(cont), idx_it(it), indices_begin(begin_it), indices_end(end_it) {}
                 
             /**
@@ -124,8 +194,23 @@ namespace container
                     throw std::out_of_range("Cannot increment iterator beyond end");
                 }
                 ++idx_it; 
+#ifdef CONTAINER_TRACING
+                if (idx_it == indices_end && traced) {
+                    trace::recordSince("traverse", trace_start, static_cast<size_t>(indices_end - indices_begin));
+                }
+#endif
                 return *this; 
             }
+
+#ifdef CONTAINER_TRACING
+            /**
+             * @brief Marks this iterator as the start of a traced walk
+             */
+            void startTrace() {
+                traced = true;
+                trace_start = trace::now();
+            }
+#endif
             
             /**
              * @brief Inequality comparison operator
@@ -150,12 +235,20 @@ namespace container
          * @brief Returns iterator pointing to the beginning of the traversal
          * @return custom_iterator pointing to the first element
          * @throws InvalidIteratorException if indices are empty
+         *
+         * With tracing compiled in, a walk from here to end() records a
+         * "traverse" span when the last element is passed; walks that stop
+         * early record nothing.
          */
         custom_iterator begin() { 
             if (indices.empty()) {
                 throw InvalidIteratorException();
             }
-            return custom_iterator(original_container, indices.begin(), indices.begin(), indices.end()); 
+            custom_iterator it(original_container, indices.begin(), indices.begin(), indices.end());
+#ifdef CONTAINER_TRACING
+            it.startTrace();
+#endif
+            return it;
         }
         
         /**
@@ -170,6 +263,96 @@ namespace container
             return custom_iterator(original_container, indices.end(), indices.begin(), indices.end()); 
         }
 
+        /**
+         * @brief Applies f to every element in traversal order, optionally prefetching ahead
+         * @param f Callable taking T&
+         * @param prefetch_distance How many elements ahead to prefetch (0, the default, disables prefetching)
+         * 
+         * Skips the per-step checks of custom_iterator. With a non-zero distance the
+         * loop also issues a prefetch for container[indices[i + distance]] while
+         * processing container[indices[i]]. That can only help orders much larger
+         * than the L2 cache, and only where the hardware prefetcher does not already
+         * keep up, so measure before enabling it.
+         */
+        template <typename F>
+        void for_each(F f, size_t prefetch_distance = DEFAULT_PREFETCH_DISTANCE) {
+            CONTAINER_TRACE_SPAN("for_each", indices.size());
+            T* data = original_container.data();
+            const size_t* idx = indices.data();
+            const size_t n = indices.size();
+            size_t k = 0;
+            if (prefetch_distance > 0 && n > prefetch_distance) {
+                for (; k + prefetch_distance < n; ++k) {
+                    prefetchRead(data + idx[k + prefetch_distance]);
+                    f(data[idx[k]]);
+                }
+            }
+            for (; k < n; ++k) {
+                f(data[idx[k]]);
+            }
+        }
+
+        /**
+         * @brief Positions of the visited elements, in traversal order
+         * @return Const reference to the index array
+         */
+        const index_vector& getIndices() const { return indices; }
+
+        /**
+         * @brief Storage this order traverses
+         * @return Const reference to the underlying vector
+         */
+        const storage_type& getContainer() const { return original_container; }
+
+        /**
+         * @brief Checks whether this order traverses the given storage
+         * @param container Storage to compare with
+         * @return True if the order was created over exactly this vector
+         */
+        bool refersTo(const storage_type& container) const { return &original_container == &container; }
+
+        /**
+         * @brief Number of elements visited by this order
+         */
+        size_t size() const { return indices.size(); }
+
+        /**
+         * @brief Copies the elements, in traversal order, into a contiguous buffer
+         * @param out Destination span with room for at least size() elements
+         * @throws IteratorException if out is too small
+         * 
+         * Bulk gather straight from the index array: no per-element checks,
+         * AVX2 gather instructions for 32/64-bit trivially copyable types and
+         * several threads for large orders.
+         */
+        void materialize(std::span<T> out) const {
+            if (out.size() < indices.size()) {
+                throw IteratorException("output span holds " + std::to_string(out.size()) +
+                                        " elements, order has " + std::to_string(indices.size()));
+            }
+            CONTAINER_TRACE_SPAN("materialize", indices.size());
+            simd::gather(original_container.data(), indices.data(), out.data(), indices.size());
+        }
+
+        /**
+         * @brief Returns the elements, in traversal order, as a new vector
+         * @return Vector of copies of the elements
+         */
+        std::vector<T> to_vector() const {
+            if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>) {
+                std::vector<T> out(indices.size());
+                materialize(out);
+                return out;
+            } else {
+                std::vector<T> out;
+                out.reserve(indices.size());
+                for (size_t index : indices) {
+                    out.push_back(original_container[index]);
+                }
+                return out;
+            }
+        }
+
         /**
          * @brief Stream output operator for printing iterator contents
          * @param os Output stream
@@ -203,6 +386,13 @@ namespace container
          * specific traversal order for each iterator type.
          */
         virtual void prepareIndices() = 0;
+
+        /**
+         * @brief Takes an index buffer from pool, or creates an empty one if pool is null
+         */
+        static index_vector borrow(index_pool_type* pool, const index_allocator_type& allocator) {
+            return pool ? pool->acquire(allocator) : index_vector(allocator);
+        }
     };
 }
 
@@ -0,0 +1,101 @@
+// galashkena1@gmail.com
+#ifndef _LAZY_ORDER_HPP_
+#define _LAZY_ORDER_HPP_
+
+#include "MyContainer.hpp"
+#include "StaticOrder.hpp"
+#include "Generator.hpp"
+
+namespace container
+{
+    /**
+     * @brief Coroutine-based versions of the six iteration orders
+     * 
+     * Each function returns a Generator that produces references to the
+     * container's elements one at a time. Positional orders (order, reverse,
+     * middleout) keep O(1) state; sorted orders borrow the container's
+     * maintained ascending permutation (MyContainer::sortedIndices()), which is
+     * only brought up to date when the consumer pulls the first element.
+     * No per-traversal index vector is materialized.
+     * 
+     * Example: auto big = lazy::descending(c) | std::views::take_while([](int v) { return v > 100; });
+     * 
+     * Like the other iterators, a generator must not outlive its container and
+     * is invalidated by adding or removing elements.
+     */
+    namespace lazy
+    {
+        /**
+         * @brief Coroutine that walks the container in the order named by Tag
+         * @param c Container to walk (must outlive the generator)
+         */
+        template <typename Tag, typename T, typename Allocator>
+        Generator<T> walk(MyContainer<T, Allocator> &c)
+        {
+            std::vector<T, Allocator>& data = c.getT();
+            const size_t* perm = nullptr;
+            if constexpr (order_traits<Tag>::sorted) {
+                perm = c.sortedIndices().data();
+            }
+            const size_t n = data.size();
+            for (size_t k = 0; k < n; ++k) {
+                co_yield data[order_traits<Tag>::index(perm, n, k)];
+            }
+        }
+
+        /**
+         * @brief Checks the container eagerly, then starts a lazy walk
+         * @throws ContainerEmptyException if the container is empty
+         */
+        template <typename Tag, typename T, typename Allocator>
+        Generator<T> start(MyContainer<T, Allocator> &c)
+        {
+            if (c.empty()) throw ContainerEmptyException();
+            return walk<Tag>(c);
+        }
+
+        /**
+         * @brief Lazy traversal in original insertion order
+         * @throws ContainerEmptyException if the container is empty
+         */
+        template <typename T, typename Allocator>
+        Generator<T> order(MyContainer<T, Allocator> &c) { return start<order_tag::order>(c); }
+
+        /**
+         * @brief Lazy traversal in reverse insertion order
+         * @throws ContainerEmptyException if the container is empty
+         */
+        template <typename T, typename Allocator>
+        Generator<T> reverse(MyContainer<T, Allocator> &c) { return start<order_tag::reverse>(c); }
+
+        /**
+         * @brief Lazy traversal from smallest to largest
+         * @throws ContainerEmptyException if the container is empty
+         */
+        template <typename T, typename Allocator>
+        Generator<T> ascending(MyContainer<T, Allocator> &c) { return start<order_tag::ascending>(c); }
+
+        /**
+         * @brief Lazy traversal from largest to smallest
+         * @throws ContainerEmptyException if the container is empty
+         */
+        template <typename T, typename Allocator>
+        Generator<T> descending(MyContainer<T, Allocator> &c) { return start<order_tag::descending>(c); }
+
+        /**
+         * @brief Lazy traversal alternating smallest and largest remaining elements
+         * @throws ContainerEmptyException if the container is empty
+         */
+        template <typename T, typename Allocator>
+        Generator<T> sidecross(MyContainer<T, Allocator> &c) { return start<order_tag::sidecross>(c); }
+
+        /**
+         * @brief Lazy traversal from the middle position outward
+         * @throws ContainerEmptyException if the container is empty
+         */
+        template <typename T, typename Allocator>
+        Generator<T> middleout(MyContainer<T, Allocator> &c) { return start<order_tag::middleout>(c); }
+    }
+}
+
+#endif
@@ -0,0 +1,275 @@
+// galashkena1@gmail.com
+#ifndef _MERGED_ORDER_HPP_
+#define _MERGED_ORDER_HPP_
+
+#include "MyContainer.hpp"
+#include "Iterator.hpp"
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace container
+{
+    /**
+     * @brief Lazily merged sorted traversal across several containers
+     *
+     * Each container contributes its own maintained ascending permutation
+     * (MyContainer::sortedIndices()), so nothing is concatenated or re-sorted.
+     * A loser tree over the N per-container cursors produces the next element
+     * with about log2(N) comparisons, for O(total * log N) overall. Matches
+     * read each source's current head from a contiguous per-leaf array that only
+     * pop() refreshes; arithmetic heads are cached by value.
+     *
+     * Example: for (auto& v : mergedAscending<int>({&part1, &part2, &part3})) { ... }
+     *
+     * Equal elements come out in container order, then in each container's own
+     * order. The view is single-pass and is invalidated by adding or removing
+     * elements in any of the containers.
+     *
+     * @tparam T The type of elements in the containers
+     * @tparam Descending False for smallest-first, true for largest-first
+     * @tparam Allocator Allocator of the containers' storage
+     */
+    template <typename T, bool Descending, typename Allocator = std::allocator<T>>
+    class MergedOrder
+    {
+    private:
+        /**
+         * @brief One input: its elements and a cursor into its ascending permutation
+         */
+        struct Source {
+            T* data;
+            const size_t* next;  ///< Cursor into the permutation (read before it when descending)
+            const size_t* stop;  ///< Cursor position once every entry has been read
+        };
+
+        /**
+         * @brief Cached head of an arithmetic source: its value and tie-break rank
+         *
+         * rank is the leaf index while the source has elements and leaves + leaf
+         * once it is exhausted. Exhaustion is read from the rank alone: a live
+         * head may hold any value of T, including infinities, so no value can
+         * serve as a sentinel.
+         */
+        struct Key {
+            std::remove_cv_t<T> value;
+            size_t rank;
+        };
+
+        static constexpr bool cache_keys = std::is_arithmetic_v<T>;
+        static constexpr std::ptrdiff_t DATA_PREFETCH_DISTANCE = 4;   ///< Elements fetched ahead per source
+        static constexpr std::ptrdiff_t PERM_PREFETCH_DISTANCE = 16;  ///< Permutation entries fetched ahead
+
+        std::vector<Source> sources;
+        std::vector<T*> heads;      ///< Current element of every leaf, nullptr once exhausted
+        std::vector<Key> keys;      ///< Cached heads by leaf (arithmetic T only)
+        std::vector<size_t> tree;   ///< tree[0] = current winner, tree[1..leaves) = losers
+        size_t leaves = 1;          ///< Number of leaves (sources padded to a power of two)
+        size_t remaining = 0;       ///< Elements not yet produced
+
+        /**
+         * @brief Moves leaf s to its next element and refreshes its cached head
+         */
+        void advance(size_t s) {
+            T* head = nullptr;
+            if (s < sources.size()) {
+                Source& source = sources[s];
+                if (source.next != source.stop) {
+                    head = source.data + (Descending ? *--source.next : *source.next++);
+                    // Sources are walked in interleaved steps, too many streams for the
+                    // hardware prefetcher: fetch the next element and a later permutation line
+                    std::ptrdiff_t left = Descending ? source.next - source.stop : source.stop - source.next;
+                    if (left > DATA_PREFETCH_DISTANCE) {
+                        prefetchRead(source.data + (Descending ? source.next[-1 - DATA_PREFETCH_DISTANCE]
+                                                               : source.next[DATA_PREFETCH_DISTANCE]));
+                    }
+                    if (left > PERM_PREFETCH_DISTANCE) {
+                        prefetchRead(Descending ? source.next - PERM_PREFETCH_DISTANCE : source.next + PERM_PREFETCH_DISTANCE);
+                    }
+                }
+            }
+            heads[s] = head;
+            if constexpr (cache_keys) {
+                keys[s] = head != nullptr ? Key{*head, s} : Key{std::remove_cv_t<T>(), leaves + s};
+            }
+        }
+
+        /**
+         * @brief True if leaf a's head should be produced before leaf b's
+         *
+         * Works on the cached heads only, never on the sources' permutations.
+         * Arithmetic heads are compared without branches: which side wins is
+         * data-dependent and a branch would mispredict about half the time.
+         */
+        bool beats(size_t a, size_t b) const {
+            if constexpr (cache_keys) {
+                return keyBeats(keys[a], keys[b]);
+            } else {
+                const T* x = heads[a];
+                const T* y = heads[b];
+                if (x == nullptr) return false;
+                if (y == nullptr) return true;
+                if (Descending ? (*y < *x) : (*x < *y)) return true;
+                if (Descending ? (*x < *y) : (*y < *x)) return false;
+                return a < b;
+            }
+        }
+
+        /**
+         * @brief beats() on two cached arithmetic heads, evaluated without branches
+         *
+         * An exhausted leaf (rank >= leaves) never wins and a live one always
+         * beats it, whatever values the two keys hold.
+         */
+        bool keyBeats(const Key& x, const Key& y) const {
+            bool live = x.rank < leaves;
+            bool other_exhausted = y.rank >= leaves;
+            bool before = Descending ? (y.value < x.value) : (x.value < y.value);
+            bool after = Descending ? (x.value < y.value) : (y.value < x.value);
+            return live & (other_exhausted | before | (!after & (x.rank < y.rank)));
+        }
+
+        /**
+         * @brief Plays the initial tournament, storing the loser of every match
+         */
+        void build() {
+            heads.assign(leaves, nullptr);
+            if constexpr (cache_keys) keys.resize(leaves);
+            for (size_t leaf = 0; leaf < leaves; ++leaf) {
+                advance(leaf);
+            }
+            std::vector<size_t> winners(2 * leaves);
+            for (size_t leaf = 0; leaf < leaves; ++leaf) {
+                winners[leaves + leaf] = leaf;
+            }
+            tree.assign(leaves, 0);
+            for (size_t node = leaves - 1; node >= 1; --node) {
+                size_t left = winners[2 * node];
+                size_t right = winners[2 * node + 1];
+                bool left_wins = beats(left, right);
+                winners[node] = left_wins ? left : right;
+                tree[node] = left_wins ? right : left;
+            }
+            tree[0] = winners[1];
+        }
+
+        /**
+         * @brief Advances the winning source and replays its path to the root
+         */
+        void pop() {
+            size_t candidate = tree[0];
+            advance(candidate);
+            --remaining;
+            size_t node = (candidate + leaves) / 2;
+            if constexpr (cache_keys) {
+                // The candidate's key stays in registers; only the stored losers are loaded
+                Key key = keys[candidate];
+                for (; node >= 1; node /= 2) {
+                    size_t other = tree[node];
+                    Key other_key = keys[other];
+                    // Selection by index so the compiler cannot turn it back into a branch
+                    size_t lost = keyBeats(other_key, key);
+                    const size_t ids[2] = {candidate, other};
+                    const Key pair[2] = {key, other_key};
+                    tree[node] = ids[1 - lost];
+                    candidate = ids[lost];
+                    key = pair[lost];
+                }
+            } else {
+                for (; node >= 1; node /= 2) {
+                    if (beats(tree[node], candidate)) {
+                        std::swap(tree[node], candidate);
+                    }
+                }
+            }
+            tree[0] = candidate;
+        }
+
+    public:
+        /**
+         * @brief Single-pass input iterator over the merged sequence
+         */
+        class iterator {
+        private:
+            MergedOrder* owner = nullptr;
+
+        public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type = std::remove_cv_t<T>;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            explicit iterator(MergedOrder* o) : owner(o) {}
+
+            T& operator*() const { return *owner->heads[owner->tree[0]]; }
+            iterator& operator++() { owner->pop(); return *this; }
+            void operator++(int) { owner->pop(); }
+
+            bool operator==(std::default_sentinel_t) const {
+                return owner == nullptr || owner->remaining == 0;
+            }
+        };
+
+        /**
+         * @brief Creates a merged view over the given containers
+         * @param containers Containers to merge (empty ones are allowed)
+         * @throws ContainerEmptyException if all containers are empty
+         */
+        explicit MergedOrder(const std::vector<MyContainer<T, Allocator>*>& containers) {
+            for (MyContainer<T, Allocator>* c : containers) {
+                if (c->empty()) continue;
+                const typename MyContainer<T, Allocator>::index_vector& perm = c->sortedIndices();
+                const size_t* first = perm.data();
+                const size_t* last = first + c->size();
+                sources.push_back(Descending ? Source{c->getT().data(), last, first}
+                                             : Source{c->getT().data(), first, last});
+                remaining += c->size();
+            }
+            if (remaining == 0) {
+                throw ContainerEmptyException();
+            }
+            while (leaves < sources.size()) {
+                leaves *= 2;
+            }
+        }
+
+        /**
+         * @brief Starts the merge; like any input range it can be walked once
+         */
+        iterator begin() {
+            build();
+            return iterator(this);
+        }
+
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+        /**
+         * @brief Number of elements left to produce
+         */
+        size_t size() const { return remaining; }
+    };
+
+    /**
+     * @brief Smallest-first traversal over all elements of several containers
+     * @param containers Containers to merge
+     * @throws ContainerEmptyException if all containers are empty
+     */
+    template <typename T, typename Allocator = std::allocator<T>>
+    MergedOrder<T, false, Allocator> mergedAscending(const std::vector<MyContainer<T, Allocator>*>& containers) {
+        return MergedOrder<T, false, Allocator>(containers);
+    }
+
+    /**
+     * @brief Largest-first traversal over all elements of several containers
+     * @param containers Containers to merge
+     * @throws ContainerEmptyException if all containers are empty
+     */
+    template <typename T, typename Allocator = std::allocator<T>>
+    MergedOrder<T, true, Allocator> mergedDescending(const std::vector<MyContainer<T, Allocator>*>& containers) {
+        return MergedOrder<T, true, Allocator>(containers);
+    }
+}
+
+#endif
@@ -19,9 +19,10 @@ namespace container
      *          MiddleOut: [C, B, D, A, E] (middle, left, right, left, right)
      * 
      * @tparam T The type of elements in the container
+     * @tparam Allocator Allocator of the container's storage
      */
-    template <typename T>
-    class MyContainer<T>::MiddleOutOrder : public Iterator<T>
+    template <typename T, typename Allocator>
+    class MyContainer<T, Allocator>::MiddleOutOrder : public Iterator<T, Allocator>
     {
     public:
         /**
@@ -30,7 +31,7 @@ namespace container
          * 
          * Automatically calls prepareIndices() to set up the middle-out traversal order.
          */
-        MiddleOutOrder(MyContainer<T> &c) : Iterator<T>(c.getT())
+        MiddleOutOrder(MyContainer<T, Allocator> &c) : Iterator<T, Allocator>(c.getT(), c.indexPool())
         {
             prepareIndices();
         }
@@ -53,6 +54,7 @@ namespace container
         {
             this->indices.clear();
             if (this->original_container.empty()) return;
+            this->indices.reserve(this->original_container.size());
             
             size_t middle = this->original_container.size() / 2;
             this->indices.push_back(middle);  
@@ -4,12 +4,25 @@
 
 #include <iostream>
 #include <vector>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <algorithm>
 #include <exception>
 #include <stdexcept>
+#include <numeric>
+#include "SortEngine.hpp"
+#include "Reductions.hpp"
+#include "Trace.hpp"
+#include "ContainerStats.hpp"
+#include "IndexPool.hpp"
 
 namespace container
 {
+    template <typename T, typename Allocator> class Iterator;
+    template <typename Tag> struct order_traits;
+    template <typename T, typename Tag> class StaticOrder;
+
     /**
      * @brief Exception thrown when trying to operate on an empty container
      * 
@@ -44,6 +57,37 @@ namespace container
             : std::out_of_range("Index " + std::to_string(index) + " is out of bounds. Container size: " + std::to_string(size)) {}
     };
 
+    /**
+     * @brief Exception thrown when an order cannot be applied to a container
+     * 
+     * This exception is thrown by physically_reorder() when the order was
+     * created for a different container or the container changed size since.
+     */
+    class OrderMismatchException : public std::invalid_argument {
+    public:
+        OrderMismatchException(const std::string& msg) : std::invalid_argument("Order mismatch: " + msg) {}
+    };
+
+    /**
+     * @brief Mutex guarding a container's lazily built caches
+     *
+     * Copies and moves start with a fresh, unlocked mutex, so containers stay
+     * copyable and (noexcept-)movable and never share a lock.
+     */
+    class CacheMutex
+    {
+    private:
+        std::mutex mutex;
+
+    public:
+        CacheMutex() = default;
+        CacheMutex(const CacheMutex&) noexcept {}
+        CacheMutex& operator=(const CacheMutex&) noexcept { return *this; }
+
+        void lock() { mutex.lock(); }
+        void unlock() { mutex.unlock(); }
+    };
+
     /**
      * @brief A container class that stores elements and provides different iteration orders
      * 
@@ -51,13 +95,45 @@ namespace container
      * elements in various orders: ascending, descending, reverse, side-cross, and middle-out.
      * You can also modify elements through iterators while maintaining the original order.
      * 
+     * Storage, the maintained sorted permutation and the index buffers of every
+     * order created from the container are allocated with Allocator (rebound to
+     * size_t for indices). With the default std::allocator the storage is a plain
+     * std::vector<T>. pmr::MyContainer<T> uses std::pmr::polymorphic_allocator:
+     * placing it in a std::pmr::monotonic_buffer_resource lets a request build
+     * it, traverse it in any order and release all of that memory at once by
+     * destroying the resource. This bounds a request's memory and frees it in
+     * one step; it is not a speedup, as the request benchmark runs at the same
+     * speed as with the default heap. Copies and moves follow the allocator's
+     * propagation rules, as std::vector does (a pmr copy uses the default
+     * resource, a move keeps the source's).
+     * 
+     * Thread safety follows the standard containers: any number of threads may
+     * read the container and create orders from it at the same time, but a
+     * thread that modifies it (add, remove, clear, physically_reorder, writing
+     * through an order) needs exclusive access. Creating a sorted order updates
+     * the maintained permutation and creating any order may create the index
+     * pool; both happen under an internal mutex.
+     * 
      * @tparam T The type of elements stored in the container (default: int)
+     * @tparam Allocator Allocator of the storage (default: std::allocator<T>)
      */
-    template <typename T = int>
+    template <typename T = int, typename Allocator = std::allocator<T>>
     class MyContainer
     {
+    public:
+        using allocator_type = Allocator;
+        using storage_type = std::vector<T, Allocator>;
+        using index_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<size_t>;
+        using index_vector = std::vector<size_t, index_allocator_type>;
+
     private:
-        std::vector<T> t;  ///< Internal storage for elements
+        storage_type t;  ///< Internal storage for elements
+        index_vector sorted_cache;  ///< Ascending permutation of the first sorted_count elements
+        size_t sorted_count = 0;           ///< Number of leading elements covered by sorted_cache
+        StatsSlot stats_slot;              ///< Performance counters, allocated by enableStats()
+        SortKernel sort_kernel = SortKernel::Auto;  ///< Algorithm used when the permutation is sorted
+        IndexPoolSlot<index_allocator_type> index_pool;  ///< Index buffers recycled between orders, created by the first order
+        CacheMutex cache_mutex;            ///< Serializes updates of sorted_cache and creation of index_pool
 
     public:
         /**
@@ -71,11 +147,28 @@ namespace container
          */
         MyContainer(size_t size) : t(size) {}
 
+        /**
+         * @brief Creates an empty container that allocates with the given allocator
+         * @param allocator Allocator for the storage and every index buffer; for
+         *                  pmr::MyContainer a std::pmr::memory_resource* that must
+         *                  outlive the container and every order created from it
+         */
+        explicit MyContainer(const Allocator& allocator) : t(allocator), sorted_cache(index_allocator_type(allocator)) {}
+
+        /**
+         * @brief Creates a container of a specific size with the given allocator
+         * @param size The initial size of the container
+         * @param allocator Allocator for the storage and every index buffer
+         */
+        MyContainer(size_t size, const Allocator& allocator)
+            : t(size, allocator), sorted_cache(index_allocator_type(allocator)) {}
+
         /**
          * @brief Adds an element to the end of the container
          * @param element The element to add
          */
         void add(const T &element) { 
+            CONTAINER_TRACE_SPAN("add", t.size());
             t.push_back(element); 
         }
 
@@ -90,20 +183,34 @@ namespace container
             if (t.empty()) {
                 throw ContainerEmptyException();
             }
+            CONTAINER_TRACE_SPAN("remove", t.size());
 
             auto it = std::find(t.begin(), t.end(), element);
             if (it == t.end()) {
-                throw ElementNotFoundException("Value: " + std::to_string(element));
+                throw ElementNotFoundException("Value: " + describe(element));
             }
 
-            // Remove all occurrences
-            for (auto it = t.begin(); it != t.end();) {
-                if (*it == element) {
-                    it = t.erase(it);
-                } else {
-                    ++it;
+            // Remove all occurrences, remembering where each survivor moves to. The map
+            // is scratch, so it stays on the heap: in an arena every remove would
+            // otherwise keep n more indices allocated until the arena is released
+            std::vector<size_t> new_position(sorted_count > 0 ? t.size() : 0, REMOVED);
+            if (ContainerStats* s = stats_slot.get(); s && sorted_count > 0) {
+                s->recordIndexAllocation(t.size() * sizeof(size_t));
+            }
+            size_t write = 0;
+            for (size_t read = 0; read < t.size(); ++read) {
+                if (!(t[read] == element)) {
+                    if (write != read) {
+                        t[write] = std::move(t[read]);
+                    }
+                    if (!new_position.empty()) {
+                        new_position[read] = write;
+                    }
+                    ++write;
                 }
             }
+            t.erase(t.begin() + write, t.end());
+            compactSortedCache(new_position);
         }
 
         /**
@@ -173,19 +280,252 @@ namespace container
         /**
          * @brief Removes all elements from the container
          */
-        void clear() { t.clear(); }
+        void clear() { 
+            t.clear(); 
+            sorted_cache.clear();
+            sorted_count = 0;
+            if (BasicIndexPool<index_allocator_type>* pool = index_pool.peek()) pool->trim();
+        }
 
         /**
          * @brief Get const reference to the internal vector
          * @return Const reference to the internal storage
          */
-        const std::vector<T> &getT() const { return t; }
+        const storage_type &getT() const { return t; }
 
         /**
          * @brief Get reference to the internal vector
          * @return Reference to the internal storage
          */
-        std::vector<T> &getT() { return t; }
+        storage_type &getT() { return t; }
+
+        /**
+         * @brief The allocator the storage and index buffers are allocated with
+         * @return Copy of the storage's allocator (for pmr::MyContainer, .resource() names the resource)
+         */
+        allocator_type get_allocator() const { return t.get_allocator(); }
+
+        /**
+         * @brief The pool orders of this container borrow their index buffers from
+         * @return Shared pointer to the pool, created on first use
+         * 
+         * Orders return their buffer when destroyed, so re-creating orders over a
+         * container whose size does not grow allocates no index memory after the
+         * first round.
+         */
+        const std::shared_ptr<BasicIndexPool<index_allocator_type>>& indexPool() {
+            std::lock_guard<CacheMutex> lock(cache_mutex);
+            return index_pool.get();
+        }
+
+        /**
+         * @brief Adds up all elements
+         * @return The total; integers are accumulated in 64 bits, floating-point
+         *         values with compensated summation. Zero for an empty container.
+         * 
+         * Aggregates do not depend on iteration order, so these run directly over
+         * the storage with SIMD kernels (multi-threaded for large containers)
+         * instead of going through an order.
+         */
+        auto sum() const {
+            if constexpr (reduce::vectorizable_v<T>) {
+                return reduce::sum(t.data(), t.size());
+            } else {
+                T total{};
+                for (const T& element : t) total = total + element;
+                return total;
+            }
+        }
+
+        /**
+         * @brief Returns the smallest element
+         * @throws ContainerEmptyException if the container is empty
+         */
+        T min() const { return minmax().first; }
+
+        /**
+         * @brief Returns the largest element
+         * @throws ContainerEmptyException if the container is empty
+         */
+        T max() const { return minmax().second; }
+
+        /**
+         * @brief Returns the smallest and largest elements in one pass
+         * @return Pair (min, max)
+         * @throws ContainerEmptyException if the container is empty
+         */
+        std::pair<T, T> minmax() const {
+            if (t.empty()) throw ContainerEmptyException();
+            if constexpr (reduce::vectorizable_v<T>) {
+                return reduce::minmax(t.data(), t.size());
+            } else {
+                auto range = std::minmax_element(t.begin(), t.end());
+                return {*range.first, *range.second};
+            }
+        }
+
+        /**
+         * @brief Returns the arithmetic mean of the elements
+         * @throws ContainerEmptyException if the container is empty
+         */
+        double mean() const {
+            static_assert(reduce::vectorizable_v<T>, "mean() requires an arithmetic element type");
+            if (t.empty()) throw ContainerEmptyException();
+            return static_cast<double>(sum()) / static_cast<double>(t.size());
+        }
+
+        /**
+         * @brief Returns the population variance of the elements
+         * @throws ContainerEmptyException if the container is empty
+         * 
+         * Uses two passes (mean, then squared deviations) to avoid the
+         * cancellation of the sum-of-squares formula.
+         */
+        double variance() const {
+            static_assert(reduce::vectorizable_v<T>, "variance() requires an arithmetic element type");
+            double center = mean();
+            return reduce::squaredDeviations(t.data(), t.size(), center) / static_cast<double>(t.size());
+        }
+
+        /**
+         * @brief Rearranges the stored elements so they sit in the given order
+         * @param order An order created from this container (e.g. ascending())
+         * @param keep_insertion_order If true, return where each element used to be
+         * @return For every new position k, the element's previous position
+         *         (empty unless keep_insertion_order is set)
+         * @throws OrderMismatchException if the order belongs to another container
+         *         or the container changed size since the order was created
+         * 
+         * After physically_reorder(ascending()) the storage itself is sorted, so
+         * later scans are sequential and order() visits elements in ascending order.
+         * The permutation is applied in place by following its cycles: each element
+         * is moved exactly once and only one visited bit per element is allocated.
+         */
+        std::vector<size_t> physically_reorder(const Iterator<T, Allocator>& order, bool keep_insertion_order = false) {
+            const index_vector& source = order.getIndices();
+            if (!order.refersTo(t)) {
+                throw OrderMismatchException("order was created for a different container");
+            }
+            if (source.size() != t.size()) {
+                throw OrderMismatchException("order covers " + std::to_string(source.size()) +
+                                             " elements, container has " + std::to_string(t.size()));
+            }
+
+            CONTAINER_TRACE_SPAN("physically_reorder", t.size());
+            // new t[k] = old t[source[k]]: walk each cycle once, carrying its first element
+            std::vector<bool> placed(t.size(), false);
+            for (size_t start = 0; start < t.size(); ++start) {
+                if (placed[start]) continue;
+                T carried = std::move(t[start]);
+                size_t position = start;
+                while (true) {
+                    placed[position] = true;
+                    size_t next = source[position];
+                    if (next == start) {
+                        t[position] = std::move(carried);
+                        break;
+                    }
+                    t[position] = std::move(t[next]);
+                    position = next;
+                }
+            }
+
+            // Element positions changed; the next sorted read rebuilds the permutation
+            // (in O(n) when the storage is now sorted)
+            sorted_cache.clear();
+            sorted_count = 0;
+
+            return keep_insertion_order ? std::vector<size_t>(source.begin(), source.end()) : std::vector<size_t>();
+        }
+
+        /**
+         * @brief Returns the ascending permutation of the current elements
+         * @return Const reference to indices i such that t[i] visits elements from smallest to largest
+         * 
+         * The permutation is maintained across calls:
+         * 1. The previously sorted run is checked in O(n) - values may have been
+         *    modified through an iterator - and fully re-sorted only if it broke
+         * 2. Elements appended since the last call (the tail) are sorted on their own
+         * 3. The sorted tail is merged into the existing run
+         * 
+         * After k appends this costs O(n + k log k) instead of a full O(n log n) sort.
+         * The reference stays valid until the next call or until elements are added or removed.
+         * Several threads may call this at once on an unmodified container: the
+         * update runs under a mutex and later callers find the permutation current.
+         */
+        const index_vector &sortedIndices() {
+            CONTAINER_TRACE_SPAN("sortedIndices", t.size());
+            std::lock_guard<CacheMutex> lock(cache_mutex);
+            auto less = [this](size_t i, size_t j) { return t[i] < t[j]; };
+
+            if (sorted_count > 0 && sorted_count <= t.size() &&
+                std::is_sorted(sorted_cache.begin(), sorted_cache.begin() + sorted_count, less)) {
+                if (sorted_count == t.size()) {
+                    return sorted_cache;
+                }
+                resizeSortedCache();
+                std::iota(sorted_cache.begin() + sorted_count, sorted_cache.end(), sorted_count);
+                sort_engine::sortByValues(t, sorted_cache.begin() + sorted_count, sorted_cache.end(), sort_kernel);
+                std::inplace_merge(sorted_cache.begin(), sorted_cache.begin() + sorted_count, sorted_cache.end(), less);
+            } else {
+                resizeSortedCache();
+                std::iota(sorted_cache.begin(), sorted_cache.end(), 0);
+                sort_engine::sortByValues(t, sorted_cache.begin(), sorted_cache.end(), sort_kernel);
+            }
+            sorted_count = t.size();
+            if (ContainerStats* s = stats_slot.get()) s->recordSort();
+            return sorted_cache;
+        }
+
+        /**
+         * @brief Chooses the sort algorithm behind every sorted order of this container
+         * @param kernel SortKernel::Auto (default), Comparison, Vectorized or Counting
+         * 
+         * All kernels produce the same permutation, so switching keeps the
+         * maintained sorted permutation valid.
+         */
+        void setSortKernel(SortKernel kernel) { sort_kernel = kernel; }
+
+        /**
+         * @brief The sort algorithm selected with setSortKernel()
+         */
+        SortKernel sortKernel() const { return sort_kernel; }
+
+        /**
+         * @brief Starts counting sorts, index allocations and order constructions
+         * 
+         * Stats are off by default; while off, the only cost is a null check
+         * per instrumented operation. Enabling them again keeps the counts.
+         */
+        void enableStats() { stats_slot.enable(); }
+
+        /**
+         * @brief Stops counting and discards the counters
+         */
+        void disableStats() { stats_slot.disable(); }
+
+        /**
+         * @brief Checks whether stats are being collected
+         */
+        bool statsEnabled() const { return stats_slot.get() != nullptr; }
+
+        /**
+         * @brief Returns the current counter values
+         * @return Snapshot of the counters (all zero while stats are disabled)
+         * 
+         * Safe to call while other threads use the container.
+         */
+        StatsSnapshot stats() const {
+            ContainerStats* s = stats_slot.get();
+            return s ? s->snapshot() : StatsSnapshot{};
+        }
+
+        /**
+         * @brief Sets every counter back to zero
+         */
+        void resetStats() {
+            if (ContainerStats* s = stats_slot.get()) s->reset();
+        }
 
         /**
          * @brief Stream output operator for printing the container
@@ -195,7 +535,7 @@ namespace container
          * 
          * Prints the container in format: [element1, element2, element3]
          */
-        friend std::ostream &operator<<(std::ostream &os, const MyContainer<T> &c)
+        friend std::ostream &operator<<(std::ostream &os, const MyContainer &c)
         {
             if (c.t.empty()) {
                 os << "[]";
@@ -219,6 +559,7 @@ namespace container
         class ReverseOrder;
         class Order;
         class MiddleOutOrder;
+        class OrderBundle;
 
         /**
          * @brief Creates an iterator that traverses elements in ascending (sorted) order
@@ -227,8 +568,25 @@ namespace container
          */
         AscendingOrder ascending() { 
             if (t.empty()) throw ContainerEmptyException();
+            CONTAINER_TRACE_SPAN("ascending", t.size());
+            StatsScope stats_scope(stats_slot.get(), newIndexBytes());
             return AscendingOrder(*this); 
         }
+
+        /**
+         * @brief Creates an ascending iterator ordered by a projected key
+         * @param proj Projection applied once per element (e.g. &Trade::price)
+         * @return AscendingOrder iterator
+         * @throws ContainerEmptyException if the container is empty
+         */
+        template <typename Proj>
+        AscendingOrder ascending(Proj proj) { 
+            if (t.empty()) throw ContainerEmptyException();
+            CONTAINER_TRACE_SPAN("ascending", t.size());
+            StatsScope stats_scope(stats_slot.get(), newIndexBytes());
+            if (ContainerStats* s = stats_slot.get()) s->recordSort();
+            return AscendingOrder(*this, proj); 
+        }
         
         /**
          * @brief Creates an iterator that traverses elements in descending order
@@ -237,8 +595,25 @@ namespace container
          */
         DescendingOrder descending() { 
             if (t.empty()) throw ContainerEmptyException();
+            CONTAINER_TRACE_SPAN("descending", t.size());
+            StatsScope stats_scope(stats_slot.get(), newIndexBytes());
             return DescendingOrder(*this); 
         }
+
+        /**
+         * @brief Creates a descending iterator ordered by a projected key
+         * @param proj Projection applied once per element (e.g. &Trade::price)
+         * @return DescendingOrder iterator
+         * @throws ContainerEmptyException if the container is empty
+         */
+        template <typename Proj>
+        DescendingOrder descending(Proj proj) { 
+            if (t.empty()) throw ContainerEmptyException();
+            CONTAINER_TRACE_SPAN("descending", t.size());
+            StatsScope stats_scope(stats_slot.get(), newIndexBytes());
+            if (ContainerStats* s = stats_slot.get()) s->recordSort();
+            return DescendingOrder(*this, proj); 
+        }
         
         /**
          * @brief Creates an iterator that alternates between smallest and largest remaining elements
@@ -247,8 +622,25 @@ namespace container
          */
         SideCrossOrder sidecross() { 
             if (t.empty()) throw ContainerEmptyException();
+            CONTAINER_TRACE_SPAN("sidecross", t.size());
+            StatsScope stats_scope(stats_slot.get(), newIndexBytes());
             return SideCrossOrder(*this); 
         }
+
+        /**
+         * @brief Creates a side-cross iterator ordered by a projected key
+         * @param proj Projection applied once per element (e.g. &Trade::price)
+         * @return SideCrossOrder iterator
+         * @throws ContainerEmptyException if the container is empty
+         */
+        template <typename Proj>
+        SideCrossOrder sidecross(Proj proj) { 
+            if (t.empty()) throw ContainerEmptyException();
+            CONTAINER_TRACE_SPAN("sidecross", t.size());
+            StatsScope stats_scope(stats_slot.get(), newIndexBytes());
+            if (ContainerStats* s = stats_slot.get()) s->recordSort();
+            return SideCrossOrder(*this, proj); 
+        }
         
         /**
          * @brief Creates an iterator that traverses elements in reverse order of insertion
@@ -257,6 +649,8 @@ namespace container
          */
         ReverseOrder reverse() { 
             if (t.empty()) throw ContainerEmptyException();
+            CONTAINER_TRACE_SPAN("reverse", t.size());
+            StatsScope stats_scope(stats_slot.get(), newIndexBytes());
             return ReverseOrder(*this); 
         }
         
@@ -267,6 +661,8 @@ namespace container
          */
         Order order() { 
             if (t.empty()) throw ContainerEmptyException();
+            CONTAINER_TRACE_SPAN("order", t.size());
+            StatsScope stats_scope(stats_slot.get(), newIndexBytes());
             return Order(*this); 
         }
         
@@ -277,9 +673,115 @@ namespace container
          */
         MiddleOutOrder middleout() { 
             if (t.empty()) throw ContainerEmptyException();
+            CONTAINER_TRACE_SPAN("middleout", t.size());
+            StatsScope stats_scope(stats_slot.get(), newIndexBytes());
             return MiddleOutOrder(*this); 
         }
+
+        /**
+         * @brief Creates a bundle that serves every order from a single sort
+         * @return OrderBundle with ascending/descending/sidecross views over one permutation
+         * @throws ContainerEmptyException if the container is empty
+         */
+        OrderBundle orders() { 
+            if (t.empty()) throw ContainerEmptyException();
+            CONTAINER_TRACE_SPAN("orders", t.size());
+            // The bundle owns a copy of the permutation, never a pooled buffer
+            StatsScope stats_scope(stats_slot.get(), t.size() * sizeof(size_t));
+            return OrderBundle(*this); 
+        }
+
+        /**
+         * @brief Creates a statically dispatched view in the order named by Tag
+         * @tparam Tag One of the order_tag types (include StaticOrder.hpp)
+         * @return Non-owning StaticOrder view; sorted tags borrow sortedIndices()
+         * @throws ContainerEmptyException if the container is empty
+         * 
+         * Example: for (auto& v : c.view<order_tag::ascending>()) { ... }
+         */
+        template <typename Tag>
+        StaticOrder<T, Tag> view() {
+            if (t.empty()) throw ContainerEmptyException();
+            if constexpr (order_traits<Tag>::sorted) {
+                return StaticOrder<T, Tag>(t.data(), t.size(), sortedIndices().data());
+            } else {
+                return StaticOrder<T, Tag>(t.data(), t.size());
+            }
+        }
+
+    private:
+        static constexpr size_t REMOVED = static_cast<size_t>(-1);  ///< Marks a removed position in compaction maps
+
+        /**
+         * @brief Bytes a new order has to allocate for its index buffer (0 if the pool can lend one)
+         */
+        size_t newIndexBytes() {
+            if (!stats_slot.get()) return 0;
+            return indexPool()->canServe(t.size()) ? 0 : t.size() * sizeof(size_t);
+        }
+
+        /**
+         * @brief Resizes sorted_cache to t.size(), counting reallocations in the stats
+         */
+        void resizeSortedCache() {
+            size_t capacity = sorted_cache.capacity();
+            sorted_cache.resize(t.size());
+            if (ContainerStats* s = stats_slot.get(); s && sorted_cache.capacity() != capacity) {
+                s->recordIndexAllocation(sorted_cache.capacity() * sizeof(size_t));
+            }
+        }
+
+        /**
+         * @brief Text used for an element in exception messages
+         * 
+         * Numbers go through std::to_string and strings are used as they are;
+         * other types get a placeholder, so remove() works for every T with operator==.
+         */
+        static std::string describe(const T& element) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                return std::to_string(element);
+            } else if constexpr (std::is_convertible_v<const T&, std::string>) {
+                return std::string(element);
+            } else {
+                return "(unprintable element)";
+            }
+        }
+
+        /**
+         * @brief Drops removed elements from the sorted permutation without re-sorting
+         * @param new_position Maps each old position to its new one, or REMOVED
+         * 
+         * Removal keeps the survivors in their relative order, so the sorted run
+         * stays sorted after renumbering; the run shrinks to the survivors among
+         * the positions it used to cover.
+         */
+        void compactSortedCache(const std::vector<size_t>& new_position) {
+            if (sorted_count == 0) {
+                return;
+            }
+            size_t write = 0;
+            for (size_t k = 0; k < sorted_count; ++k) {
+                size_t moved = new_position[sorted_cache[k]];
+                if (moved != REMOVED) {
+                    sorted_cache[write++] = moved;
+                }
+            }
+            sorted_cache.resize(write);
+            sorted_count = write;
+        }
     };
+
+    namespace pmr
+    {
+        /**
+         * @brief MyContainer whose storage and index buffers come from a std::pmr::memory_resource
+         *
+         * Example: std::pmr::monotonic_buffer_resource arena;
+         *          container::pmr::MyContainer<int> c(&arena);
+         */
+        template <typename T = int>
+        using MyContainer = container::MyContainer<T, std::pmr::polymorphic_allocator<T>>;
+    }
 }
 
 #endif
\ No newline at end of file
@@ -18,9 +18,10 @@ namespace container
      *          (same as insertion order)
      * 
      * @tparam T The type of elements in the container
+     * @tparam Allocator Allocator of the container's storage
      */
-    template <typename T>
-    class MyContainer<T>::Order : public Iterator<T>
+    template <typename T, typename Allocator>
+    class MyContainer<T, Allocator>::Order : public Iterator<T, Allocator>
     {
     public:
         /**
@@ -29,7 +30,7 @@ namespace container
          * 
          * Automatically calls prepareIndices() to set up the natural traversal order.
          */
-        Order(MyContainer<T> &c) : Iterator<T>(c.getT())
+        Order(MyContainer<T, Allocator> &c) : Iterator<T, Allocator>(c.getT(), c.indexPool())
         {
             prepareIndices();
         }
@@ -0,0 +1,89 @@
+// galashkena1@gmail.com
+#ifndef _ORDER_BUNDLE_HPP_
+#define _ORDER_BUNDLE_HPP_
+
+#include "MyContainer.hpp"
+#include "StaticOrder.hpp"
+#include <vector>
+
+namespace container
+{
+    /**
+     * @brief All six traversal orders served from a single sort
+     * 
+     * The bundle takes one snapshot of the container's ascending permutation
+     * and hands out lightweight StaticOrder views over it:
+     * - ascending walks the permutation forwards
+     * - descending walks it backwards
+     * - sidecross walks it with two cursors, one from each end
+     * - order, reverse and middleout are positional and use no storage at all
+     * 
+     * Example: auto all = c.orders();
+     *          for (auto& v : all.ascending()) ...
+     *          for (auto& v : all.descending()) ...   // no second sort
+     * 
+     * The views reference the container's elements, so they are invalidated by
+     * adding or removing elements, exactly like the other iterators.
+     * 
+     * @tparam T The type of elements in the container
+     * @tparam Allocator Allocator of the container's storage
+     */
+    template <typename T, typename Allocator>
+    class MyContainer<T, Allocator>::OrderBundle
+    {
+    private:
+        storage_type& original_container;  ///< Elements being traversed
+        index_vector sorted;               ///< Ascending permutation shared by the sorted views, with the container's allocator
+
+    public:
+        /**
+         * @brief Constructor that sorts the container once for all orders
+         * @param c Reference to the MyContainer to iterate over
+         */
+        OrderBundle(MyContainer<T, Allocator> &c) : original_container(c.getT()), sorted(c.sortedIndices(), index_allocator_type(c.get_allocator())) {}
+
+        /**
+         * @brief Elements from smallest to largest
+         */
+        StaticOrder<T, order_tag::ascending> ascending() const {
+            return StaticOrder<T, order_tag::ascending>(original_container.data(), sorted.size(), sorted.data());
+        }
+
+        /**
+         * @brief Elements from largest to smallest (reverse walk of the permutation)
+         */
+        StaticOrder<T, order_tag::descending> descending() const {
+            return StaticOrder<T, order_tag::descending>(original_container.data(), sorted.size(), sorted.data());
+        }
+
+        /**
+         * @brief Smallest, largest, second smallest, ... (two-cursor walk of the permutation)
+         */
+        StaticOrder<T, order_tag::sidecross> sidecross() const {
+            return StaticOrder<T, order_tag::sidecross>(original_container.data(), sorted.size(), sorted.data());
+        }
+
+        /**
+         * @brief Elements in insertion order
+         */
+        StaticOrder<T, order_tag::order> order() const {
+            return StaticOrder<T, order_tag::order>(original_container.data(), sorted.size());
+        }
+
+        /**
+         * @brief Elements in reverse insertion order
+         */
+        StaticOrder<T, order_tag::reverse> reverse() const {
+            return StaticOrder<T, order_tag::reverse>(original_container.data(), sorted.size());
+        }
+
+        /**
+         * @brief Middle element first, then expanding outward
+         */
+        StaticOrder<T, order_tag::middleout> middleout() const {
+            return StaticOrder<T, order_tag::middleout>(original_container.data(), sorted.size());
+        }
+    };
+}
+
+#endif
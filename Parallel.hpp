@@ -0,0 +1,118 @@
+// galashkena1@gmail.com
+#ifndef _PARALLEL_HPP_
+#define _PARALLEL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace container
+{
+    namespace parallel
+    {
+        /**
+         * @brief Number of threads worth using for data-parallel work
+         */
+        inline size_t workerCount() {
+            unsigned hardware = std::thread::hardware_concurrency();
+            return hardware == 0 ? 1 : hardware;
+        }
+
+        /**
+         * @brief Number of chunks forChunks() splits n items into
+         * @param n Number of items
+         * @param min_chunk Smallest chunk worth handing to its own thread
+         */
+        inline size_t chunkCount(size_t n, size_t min_chunk) {
+            size_t by_size = min_chunk == 0 ? n : n / min_chunk;
+            return std::max<size_t>(1, std::min(workerCount(), by_size));
+        }
+
+        /**
+         * @brief Joins every started thread of a list when it goes out of scope
+         *
+         * The threads reference the caller's stack, so they must finish before
+         * it unwinds, also when starting a later thread throws.
+         */
+        class ThreadJoiner
+        {
+        private:
+            std::vector<std::thread>& threads;
+
+        public:
+            explicit ThreadJoiner(std::vector<std::thread>& t) : threads(t) {}
+            ThreadJoiner(const ThreadJoiner&) = delete;
+            ThreadJoiner& operator=(const ThreadJoiner&) = delete;
+
+            ~ThreadJoiner() {
+                for (std::thread& thread : threads) {
+                    if (thread.joinable()) thread.join();
+                }
+            }
+        };
+
+        /**
+         * @brief Splits [0, n) into the given number of contiguous chunks and runs f(chunk, begin, end) on each
+         * @param chunks Number of chunks (1 runs f once on the calling thread)
+         * @param n Number of items
+         * @param f Callable taking (size_t chunk, size_t begin, size_t end)
+         * 
+         * Chunk 0 runs on the calling thread, the others on short-lived threads.
+         * The first exception thrown by any chunk is rethrown after all chunks finish.
+         * If a thread cannot be started (std::system_error), the threads already
+         * running are joined and that error is rethrown.
+         */
+        template <typename F>
+        void forEachChunk(size_t chunks, size_t n, F f) {
+            if (chunks <= 1) {
+                f(size_t(0), size_t(0), n);
+                return;
+            }
+
+            const size_t step = (n + chunks - 1) / chunks;
+            std::vector<std::exception_ptr> errors(chunks);
+            std::vector<std::thread> threads;
+            threads.reserve(chunks - 1);
+            {
+                ThreadJoiner joiner(threads);
+                for (size_t c = 1; c < chunks; ++c) {
+                    size_t begin = std::min(n, c * step);
+                    size_t end = std::min(n, begin + step);
+                    threads.emplace_back([&f, &errors, c, begin, end] {
+                        try {
+                            f(c, begin, end);
+                        } catch (...) {
+                            errors[c] = std::current_exception();
+                        }
+                    });
+                }
+                try {
+                    f(size_t(0), size_t(0), std::min(n, step));
+                } catch (...) {
+                    errors[0] = std::current_exception();
+                }
+            }
+            for (const std::exception_ptr& error : errors) {
+                if (error) std::rethrow_exception(error);
+            }
+        }
+
+        /**
+         * @brief Splits [0, n) into contiguous chunks and runs f(chunk, begin, end) on each
+         * @param n Number of items
+         * @param min_chunk Smallest chunk worth handing to its own thread
+         * @param f Callable taking (size_t chunk, size_t begin, size_t end)
+         * 
+         * Uses chunkCount(n, min_chunk) chunks, so small inputs run as a single
+         * chunk without starting any thread.
+         */
+        template <typename F>
+        void forChunks(size_t n, size_t min_chunk, F f) {
+            forEachChunk(chunkCount(n, min_chunk), n, f);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,372 @@
+// galashkena1@gmail.com
+#ifndef _PARTITIONED_CONTAINER_HPP_
+#define _PARTITIONED_CONTAINER_HPP_
+
+#include "MyContainer.hpp"
+#include "MergedOrder.hpp"
+#include "Generator.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace container
+{
+    /**
+     * @brief How PartitionedContainer assigns elements to partitions
+     */
+    enum class PartitionScheme {
+        Hash,   ///< By hash of the element: even spread, sorted orders merge the partitions
+        Range   ///< By user-supplied splitters: sorted orders just concatenate the partitions
+    };
+
+    /**
+     * @brief True if std::hash<T> is enabled, as PartitionScheme::Hash requires
+     */
+    template <typename T>
+    inline constexpr bool is_hashable_v = requires(const T& value) { std::hash<T>{}(value); };
+
+    /**
+     * @brief A container split into P independent MyContainer partitions
+     *
+     * Instead of one large vector and one large sort, elements are spread over
+     * partitions that are meant to stay cache-sized (see partitionsFor()).
+     * Each partition keeps its own maintained sorted permutation, and the
+     * partitions are brought up to date in parallel before any sorted traversal.
+     *
+     * All six orders are exposed as Generators over element references:
+     * - order, reverse and middleout treat the partitions as one concatenated
+     *   sequence (partition 0 first)
+     * - with PartitionScheme::Range, ascending and descending concatenate the
+     *   sorted partitions, since every partition holds one key range
+     * - with PartitionScheme::Hash, ascending and descending merge the sorted
+     *   partitions with a loser tree (see MergedOrder)
+     * - sidecross alternates between an ascending and a descending stream
+     *
+     * Equal elements always land in the same partition, so remove() only
+     * touches one partition.
+     *
+     * Like the other iterators, a generator must not outlive its container and
+     * is invalidated by adding or removing elements.
+     *
+     * @tparam T The type of elements stored in the container
+     */
+    template <typename T = int>
+    class PartitionedContainer
+    {
+    private:
+        std::vector<MyContainer<T>> parts;  ///< The partitions
+        std::vector<T> splitters;           ///< Upper bounds of partitions 0..P-2 (Range only)
+        PartitionScheme scheme;             ///< How elements are assigned to partitions
+
+        /**
+         * @brief Index of the partition that holds (or would hold) element
+         *
+         * The hash is multiplied by a 64-bit odd constant and its high bits are
+         * used, so identity hashes of patterned integers still spread evenly.
+         */
+        size_t partitionOf(const T& element) const {
+            if (scheme == PartitionScheme::Range) {
+                return static_cast<size_t>(std::upper_bound(splitters.begin(), splitters.end(), element) - splitters.begin());
+            }
+            // Only the hash constructor selects Hash, and it requires std::hash<T>
+            if constexpr (is_hashable_v<T>) {
+                uint64_t mixed = static_cast<uint64_t>(std::hash<T>{}(element)) * 0x9E3779B97F4A7C15ull;
+                return static_cast<size_t>((static_cast<unsigned __int128>(mixed) * parts.size()) >> 64);
+            } else {
+                return 0;
+            }
+        }
+
+        /**
+         * @brief Pointers to all partitions, as expected by MergedOrder
+         */
+        std::vector<MyContainer<T>*> partitionPointers() {
+            std::vector<MyContainer<T>*> pointers;
+            pointers.reserve(parts.size());
+            for (MyContainer<T>& part : parts) {
+                pointers.push_back(&part);
+            }
+            return pointers;
+        }
+
+        Generator<T> walkForward() {
+            for (MyContainer<T>& part : parts) {
+                for (T& element : part.getT()) {
+                    co_yield element;
+                }
+            }
+        }
+
+        Generator<T> walkBackward() {
+            for (size_t p = parts.size(); p-- > 0;) {
+                std::vector<T>& data = parts[p].getT();
+                for (size_t i = data.size(); i-- > 0;) {
+                    co_yield data[i];
+                }
+            }
+        }
+
+        /**
+         * @brief Walks the concatenated sequence from the middle position outward
+         *
+         * Follows order_traits<order_tag::middleout>: the middle first, then one
+         * step left and one step right alternately. Two (partition, offset)
+         * cursors move across partition boundaries, skipping empty partitions.
+         */
+        Generator<T> walkMiddleOut() {
+            const size_t n = size();
+            size_t middle = n / 2;
+            size_t part = 0;
+            while (middle >= parts[part].size()) {
+                middle -= parts[part].size();
+                ++part;
+            }
+            size_t left_part = part, left = middle;
+            size_t right_part = part, right = middle;
+            co_yield parts[part].getT()[middle];
+            for (size_t k = 1; k < n; ++k) {
+                if (k & 1) {
+                    while (left == 0) {
+                        --left_part;
+                        left = parts[left_part].size();
+                    }
+                    --left;
+                    co_yield parts[left_part].getT()[left];
+                } else {
+                    ++right;
+                    while (right == parts[right_part].size()) {
+                        ++right_part;
+                        right = 0;
+                    }
+                    co_yield parts[right_part].getT()[right];
+                }
+            }
+        }
+
+        /**
+         * @brief Brings every partition's permutation up to date, see sortPartitions()
+         * @return Each partition's ascending permutation, in partition order
+         */
+        std::vector<const std::vector<size_t>*> sortedPermutations() {
+            std::vector<const std::vector<size_t>*> perms(parts.size());
+            size_t chunks = std::min(parallel::workerCount(), parts.size());
+            parallel::forEachChunk(chunks, parts.size(), [this, &perms](size_t, size_t begin, size_t end) {
+                for (size_t p = begin; p < end; ++p) {
+                    perms[p] = &parts[p].sortedIndices();
+                }
+            });
+            return perms;
+        }
+
+        /**
+         * @brief Smallest-first (or largest-first) walk over all partitions
+         * @tparam Descending True for largest-first
+         * @param perms Result of sortedPermutations(), read without validating again
+         */
+        template <bool Descending>
+        Generator<T> walkSorted(std::vector<const std::vector<size_t>*> perms) {
+            if (scheme == PartitionScheme::Range) {
+                for (size_t q = 0; q < parts.size(); ++q) {
+                    size_t p = Descending ? parts.size() - 1 - q : q;
+                    std::vector<T>& data = parts[p].getT();
+                    const std::vector<size_t>& perm = *perms[p];
+                    for (size_t k = 0; k < perm.size(); ++k) {
+                        co_yield data[perm[Descending ? perm.size() - 1 - k : k]];
+                    }
+                }
+            } else {
+                MergedOrder<T, Descending> merged(partitionPointers());
+                for (T& element : merged) {
+                    co_yield element;
+                }
+            }
+        }
+
+        Generator<T> walkSideCross() {
+            const size_t n = size();
+            // Both streams read the same permutations: bring them up to date once
+            std::vector<const std::vector<size_t>*> perms = sortedPermutations();
+            Generator<T> up = walkSorted<false>(perms);
+            Generator<T> down = walkSorted<true>(std::move(perms));
+            auto low = up.begin();
+            auto high = down.begin();
+            for (size_t k = 0; k < n; ++k) {
+                if (k & 1) {
+                    co_yield *high;
+                    ++high;
+                } else {
+                    co_yield *low;
+                    ++low;
+                }
+            }
+        }
+
+        void requireNonEmpty() const {
+            if (empty()) throw ContainerEmptyException();
+        }
+
+    public:
+        /**
+         * @brief Suggested partition size in bytes (roughly a per-core L2 cache)
+         */
+        static constexpr size_t PARTITION_BYTES = size_t(256) * 1024;
+
+        /**
+         * @brief Number of partitions that keeps each one within PARTITION_BYTES
+         * @param expected_elements Expected total number of elements
+         * @return At least 1
+         */
+        static size_t partitionsFor(size_t expected_elements) {
+            size_t per_partition = std::max<size_t>(1, PARTITION_BYTES / sizeof(T));
+            return std::max<size_t>(1, (expected_elements + per_partition - 1) / per_partition);
+        }
+
+        /**
+         * @brief Creates a hash-partitioned container
+         * @param partitions Number of partitions
+         * @throws std::invalid_argument if partitions is 0
+         *
+         * Requires std::hash<T>; types with only operator< can use range partitioning.
+         */
+        explicit PartitionedContainer(size_t partitions) : scheme(PartitionScheme::Hash) {
+            static_assert(is_hashable_v<T>,
+                          "Hash partitioning requires std::hash<T> - pass splitters for range partitioning instead");
+            if (partitions == 0) {
+                throw std::invalid_argument("PartitionedContainer needs at least one partition");
+            }
+            parts.resize(partitions);
+        }
+
+        /**
+         * @brief Creates a range-partitioned container
+         * @param bounds Strictly increasing splitters; partition p holds the
+         *               elements e with bounds[p-1] <= e < bounds[p]
+         * @throws std::invalid_argument if bounds are not strictly increasing
+         *
+         * There are bounds.size() + 1 partitions.
+         */
+        explicit PartitionedContainer(std::vector<T> bounds)
+            : splitters(std::move(bounds)), scheme(PartitionScheme::Range) {
+            for (size_t i = 1; i < splitters.size(); ++i) {
+                if (!(splitters[i - 1] < splitters[i])) {
+                    throw std::invalid_argument("PartitionedContainer splitters must be strictly increasing");
+                }
+            }
+            parts.resize(splitters.size() + 1);
+        }
+
+        /**
+         * @brief Adds an element to its partition
+         * @param element The element to add
+         */
+        void add(const T& element) {
+            parts[partitionOf(element)].add(element);
+        }
+
+        /**
+         * @brief Removes all occurrences of the specified element
+         * @param element The element to remove
+         * @throws ContainerEmptyException if the container is empty
+         * @throws ElementNotFoundException if the element is not found
+         */
+        void remove(const T& element) {
+            requireNonEmpty();
+            parts[partitionOf(element)].remove(element);
+        }
+
+        /**
+         * @brief Total number of elements over all partitions
+         */
+        size_t size() const {
+            size_t total = 0;
+            for (const MyContainer<T>& part : parts) total += part.size();
+            return total;
+        }
+
+        /**
+         * @brief Checks if every partition is empty
+         */
+        bool empty() const {
+            return std::all_of(parts.begin(), parts.end(), [](const MyContainer<T>& part) { return part.empty(); });
+        }
+
+        /**
+         * @brief Removes all elements, keeping the partitioning
+         */
+        void clear() {
+            for (MyContainer<T>& part : parts) part.clear();
+        }
+
+        /**
+         * @brief The partitioning scheme chosen at construction
+         */
+        PartitionScheme partitionScheme() const { return scheme; }
+
+        /**
+         * @brief Number of partitions
+         */
+        size_t partitionCount() const { return parts.size(); }
+
+        /**
+         * @brief Access to a single partition
+         * @param p Partition index
+         * @throws IndexOutOfBoundsException if p >= partitionCount()
+         */
+        MyContainer<T>& partition(size_t p) {
+            if (p >= parts.size()) throw IndexOutOfBoundsException(p, parts.size());
+            return parts[p];
+        }
+
+        /**
+         * @brief Brings every partition's sorted permutation up to date
+         *
+         * Partitions are split across worker threads (see parallel::forEachChunk).
+         * Partitions whose permutation is already current only pay the O(n)
+         * validation in MyContainer::sortedIndices(). Sorted traversals call
+         * this automatically.
+         */
+        void sortPartitions() { sortedPermutations(); }
+
+        /**
+         * @brief Traversal in partition order, each partition in insertion order
+         * @throws ContainerEmptyException if the container is empty
+         */
+        Generator<T> order() { requireNonEmpty(); return walkForward(); }
+
+        /**
+         * @brief Exact reverse of order()
+         * @throws ContainerEmptyException if the container is empty
+         */
+        Generator<T> reverse() { requireNonEmpty(); return walkBackward(); }
+
+        /**
+         * @brief Middle-out traversal over the sequence produced by order()
+         * @throws ContainerEmptyException if the container is empty
+         */
+        Generator<T> middleout() { requireNonEmpty(); return walkMiddleOut(); }
+
+        /**
+         * @brief Traversal from smallest to largest over all partitions
+         * @throws ContainerEmptyException if the container is empty
+         */
+        Generator<T> ascending() { requireNonEmpty(); return walkSorted<false>(sortedPermutations()); }
+
+        /**
+         * @brief Traversal from largest to smallest over all partitions
+         * @throws ContainerEmptyException if the container is empty
+         */
+        Generator<T> descending() { requireNonEmpty(); return walkSorted<true>(sortedPermutations()); }
+
+        /**
+         * @brief Alternates smallest and largest remaining elements over all partitions
+         * @throws ContainerEmptyException if the container is empty
+         */
+        Generator<T> sidecross() { requireNonEmpty(); return walkSideCross(); }
+    };
+}
+
+#endif
@@ -0,0 +1,274 @@
+// galashkena1@gmail.com
+#ifndef _REDUCTIONS_HPP_
+#define _REDUCTIONS_HPP_
+
+#include "Parallel.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace container
+{
+    /**
+     * @brief Order-independent aggregate kernels over contiguous storage
+     *
+     * Arithmetic types are processed LANES elements at a time with GCC/Clang
+     * vector extensions, which compile to SIMD instructions for the target;
+     * inputs larger than PARALLEL_CHUNK elements are split across threads and
+     * the per-chunk results combined. Floating-point sums use Kahan compensation
+     * per lane and Neumaier compensation when lanes and chunks are combined.
+     */
+    namespace reduce
+    {
+        /**
+         * @brief Number of elements processed per vector step
+         */
+        inline constexpr size_t LANES = 8;
+
+        /**
+         * @brief Smallest number of elements a reduction thread is given
+         */
+        inline constexpr size_t PARALLEL_CHUNK = size_t(1) << 16;
+
+        /**
+         * @brief Vector of LANES elements of type T
+         */
+        template <typename T>
+        struct lanes {
+            typedef T type __attribute__((vector_size(LANES * sizeof(T))));
+        };
+
+        template <typename T>
+        using lanes_t = typename lanes<T>::type;
+
+        /**
+         * @brief Vector of one 16-byte register of T (SSE/NEON width)
+         * 
+         * Comparisons on wider generic vectors are split poorly by GCC when
+         * the baseline target has no 256-bit registers, so the min/max kernel
+         * works on register-sized vectors.
+         */
+        template <typename T>
+        struct register_lanes {
+            typedef T type __attribute__((vector_size(16)));
+            static constexpr size_t count = 16 / sizeof(T);
+        };
+
+        /**
+         * @brief Types the SIMD kernels handle (every arithmetic type except bool)
+         */
+        template <typename T>
+        inline constexpr bool vectorizable_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+        /**
+         * @brief Accumulator type used by sum(): 64-bit for integers, T otherwise
+         */
+        template <typename T>
+        using sum_t = std::conditional_t<std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                                         std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>,
+                                         T>;
+
+        /**
+         * @brief Loads LANES consecutive elements (no alignment requirement)
+         * 
+         * Takes an output parameter rather than returning the vector, which
+         * keeps wide vectors out of the function-call ABI.
+         */
+        template <typename V, typename T>
+        void load(V& v, const T* p) {
+            std::memcpy(&v, p, sizeof(v));
+        }
+
+        /**
+         * @brief Lane-wise acc = (take ? v : acc), where take is a comparison mask
+         * 
+         * Lanes are blended through their bit patterns with and/andnot/or,
+         * which GCC keeps in vector registers for every element type (the
+         * vector ?: operator is scalarized in several cases).
+         */
+        template <typename V, typename Mask>
+        void blend(V& acc, const V& v, const Mask& take) {
+            acc = (V)((take & (Mask)v) | (~take & (Mask)acc));
+        }
+
+        /**
+         * @brief Running sum with a Neumaier compensation term
+         */
+        template <typename F>
+        struct CompensatedSum {
+            F sum = F(0);
+            F compensation = F(0);
+
+            void add(F x) {
+                F t = sum + x;
+                if (std::fabs(sum) >= std::fabs(x)) {
+                    compensation += (sum - t) + x;
+                } else {
+                    compensation += (x - t) + sum;
+                }
+                sum = t;
+            }
+
+            F value() const { return sum + compensation; }
+        };
+
+        /**
+         * @brief Single-threaded sum of n elements
+         */
+        template <typename T>
+        sum_t<T> sumSerial(const T* data, size_t n) {
+            using S = sum_t<T>;
+            size_t k = 0;
+            if constexpr (std::is_floating_point_v<T>) {
+                lanes_t<T> sum = {};
+                lanes_t<T> comp = {};
+                lanes_t<T> x;
+                for (; k + LANES <= n; k += LANES) {
+                    load(x, data + k);
+                    lanes_t<T> y = x - comp;
+                    lanes_t<T> t = sum + y;
+                    comp = (t - sum) - y;
+                    sum = t;
+                }
+                CompensatedSum<T> total;
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    total.add(sum[lane]);
+                    total.add(-comp[lane]);
+                }
+                for (; k < n; ++k) total.add(data[k]);
+                return total.value();
+            } else {
+                lanes_t<S> sum = {};
+                lanes_t<T> x;
+                for (; k + LANES <= n; k += LANES) {
+                    load(x, data + k);
+                    sum += __builtin_convertvector(x, lanes_t<S>);
+                }
+                S total = 0;
+                for (size_t lane = 0; lane < LANES; ++lane) total += sum[lane];
+                for (; k < n; ++k) total += static_cast<S>(data[k]);
+                return total;
+            }
+        }
+
+        /**
+         * @brief Single-threaded minimum and maximum of n > 0 elements
+         */
+        template <typename T>
+        std::pair<T, T> minmaxSerial(const T* data, size_t n) {
+            using V = typename register_lanes<T>::type;
+            constexpr size_t WIDTH = register_lanes<T>::count;
+            T low = data[0];
+            T high = data[0];
+            size_t k = 0;
+            if (n >= WIDTH) {
+                V vlow;
+                load(vlow, data);
+                V vhigh = vlow;
+                V v;
+                for (k = WIDTH; k + WIDTH <= n; k += WIDTH) {
+                    load(v, data + k);
+                    blend(vlow, v, v < vlow);
+                    blend(vhigh, v, v > vhigh);
+                }
+                for (size_t lane = 0; lane < WIDTH; ++lane) {
+                    if (vlow[lane] < low) low = vlow[lane];
+                    if (vhigh[lane] > high) high = vhigh[lane];
+                }
+            }
+            for (; k < n; ++k) {
+                if (data[k] < low) low = data[k];
+                if (data[k] > high) high = data[k];
+            }
+            return {low, high};
+        }
+
+        /**
+         * @brief Single-threaded sum of (x - mean)^2, accumulated in double
+         */
+        template <typename T>
+        double squaredDeviationsSerial(const T* data, size_t n, double mean) {
+            lanes_t<double> sum = {};
+            lanes_t<double> comp = {};
+            lanes_t<double> center = {};
+            center += mean;
+            lanes_t<T> x;
+            size_t k = 0;
+            for (; k + LANES <= n; k += LANES) {
+                load(x, data + k);
+                lanes_t<double> d = __builtin_convertvector(x, lanes_t<double>) - center;
+                lanes_t<double> y = d * d - comp;
+                lanes_t<double> t = sum + y;
+                comp = (t - sum) - y;
+                sum = t;
+            }
+            CompensatedSum<double> total;
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                total.add(sum[lane]);
+                total.add(-comp[lane]);
+            }
+            for (; k < n; ++k) {
+                double d = static_cast<double>(data[k]) - mean;
+                total.add(d * d);
+            }
+            return total.value();
+        }
+
+        /**
+         * @brief Sum of n elements, multi-threaded for large n
+         */
+        template <typename T>
+        sum_t<T> sum(const T* data, size_t n) {
+            std::vector<sum_t<T>> partial(parallel::chunkCount(n, PARALLEL_CHUNK));
+            parallel::forChunks(n, PARALLEL_CHUNK, [&](size_t chunk, size_t begin, size_t end) {
+                partial[chunk] = sumSerial(data + begin, end - begin);
+            });
+            if constexpr (std::is_floating_point_v<T>) {
+                CompensatedSum<T> total;
+                for (T value : partial) total.add(value);
+                return total.value();
+            } else {
+                sum_t<T> total = 0;
+                for (sum_t<T> value : partial) total += value;
+                return total;
+            }
+        }
+
+        /**
+         * @brief Minimum and maximum of n > 0 elements, multi-threaded for large n
+         */
+        template <typename T>
+        std::pair<T, T> minmax(const T* data, size_t n) {
+            std::vector<std::pair<T, T>> partial(parallel::chunkCount(n, PARALLEL_CHUNK));
+            parallel::forChunks(n, PARALLEL_CHUNK, [&](size_t chunk, size_t begin, size_t end) {
+                partial[chunk] = minmaxSerial(data + begin, end - begin);
+            });
+            std::pair<T, T> result = partial[0];
+            for (const auto& range : partial) {
+                if (range.first < result.first) result.first = range.first;
+                if (range.second > result.second) result.second = range.second;
+            }
+            return result;
+        }
+
+        /**
+         * @brief Sum of squared deviations from mean, multi-threaded for large n
+         */
+        template <typename T>
+        double squaredDeviations(const T* data, size_t n, double mean) {
+            std::vector<double> partial(parallel::chunkCount(n, PARALLEL_CHUNK));
+            parallel::forChunks(n, PARALLEL_CHUNK, [&](size_t chunk, size_t begin, size_t end) {
+                partial[chunk] = squaredDeviationsSerial(data + begin, end - begin, mean);
+            });
+            CompensatedSum<double> total;
+            for (double value : partial) total.add(value);
+            return total.value();
+        }
+    }
+}
+
+#endif
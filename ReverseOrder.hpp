@@ -20,9 +20,10 @@ namespace container
      *          (last inserted first, first inserted last)
      * 
      * @tparam T The type of elements in the container
+     * @tparam Allocator Allocator of the container's storage
      */
-    template <typename T>
-    class MyContainer<T>::ReverseOrder : public Iterator<T>
+    template <typename T, typename Allocator>
+    class MyContainer<T, Allocator>::ReverseOrder : public Iterator<T, Allocator>
     {
     public:
         /**
@@ -31,7 +32,7 @@ namespace container
          * 
          * Automatically calls prepareIndices() to set up the reversed traversal order.
          */
-        ReverseOrder(MyContainer<T> &c) : Iterator<T>(c.getT())
+        ReverseOrder(MyContainer<T, Allocator> &c) : Iterator<T, Allocator>(c.getT(), c.indexPool())
         {
             prepareIndices();
         }
@@ -0,0 +1,160 @@
+// galashkena1@gmail.com
+#ifndef _SCAN_HPP_
+#define _SCAN_HPP_
+
+#include "Iterator.hpp"
+#include "Parallel.hpp"
+#include <functional>
+#include <ranges>
+#include <string>
+#include <vector>
+
+namespace container
+{
+    /**
+     * @brief Prefix scans (running totals) over the elements of any order
+     * 
+     * The scans follow the order's index sequence, so an inclusive scan over
+     * ascending() yields an empirical CDF numerator, over order() a plain running
+     * total, and so on. Operators must be associative; they need not be commutative.
+     * 
+     * Large orders run as a work-efficient two-pass scan across threads:
+     * 1. Every chunk reduces its own slice of the index sequence
+     * 2. The chunk totals are scanned sequentially into per-chunk carries
+     * 3. Every chunk scans its slice again, starting from its carry
+     * That is about 2n operator applications in total, independent of thread count.
+     */
+    namespace scan
+    {
+        /**
+         * @brief Smallest number of elements a scan thread is given
+         */
+        inline constexpr size_t PARALLEL_CHUNK = size_t(1) << 16;
+
+        /**
+         * @brief Scan kernel with an explicit chunk count
+         * @param data Element storage
+         * @param idx Index sequence to follow
+         * @param n Number of indices
+         * @param out Output buffer with room for n values
+         * @param init Value placed before the first element (exclusive scan only)
+         * @param op Associative binary operator on R
+         * @param inclusive True for inclusive, false for exclusive
+         * @param chunks Number of chunks to split the work into
+         */
+        template <typename T, typename R, typename Op>
+        void scanChunks(const T* data, const size_t* idx, size_t n, R* out, const R& init,
+                        Op op, bool inclusive, size_t chunks)
+        {
+            if (chunks <= 1) {
+                R running = inclusive ? R(data[idx[0]]) : init;
+                for (size_t k = 0; k < n; ++k) {
+                    if (inclusive) {
+                        if (k > 0) running = op(running, R(data[idx[k]]));
+                        out[k] = running;
+                    } else {
+                        out[k] = running;
+                        running = op(running, R(data[idx[k]]));
+                    }
+                }
+                return;
+            }
+
+            // Pass 1: reduce each chunk
+            std::vector<R> totals(chunks);
+            std::vector<char> nonEmpty(chunks, 0);  // one byte per chunk: written concurrently
+            parallel::forEachChunk(chunks, n, [&](size_t chunk, size_t begin, size_t end) {
+                if (begin == end) return;
+                R total = R(data[idx[begin]]);
+                for (size_t k = begin + 1; k < end; ++k) {
+                    total = op(total, R(data[idx[k]]));
+                }
+                totals[chunk] = total;
+                nonEmpty[chunk] = 1;
+            });
+
+            // Carries: combined totals of all earlier chunks (plus init for exclusive scans)
+            std::vector<R> carries(chunks);
+            std::vector<char> hasCarry(chunks, 0);
+            bool started = !inclusive;
+            R running = init;
+            for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                if (started) {
+                    carries[chunk] = running;
+                    hasCarry[chunk] = 1;
+                }
+                if (nonEmpty[chunk]) {
+                    running = started ? op(running, totals[chunk]) : totals[chunk];
+                    started = true;
+                }
+            }
+
+            // Pass 2: scan each chunk from its carry
+            parallel::forEachChunk(chunks, n, [&](size_t chunk, size_t begin, size_t end) {
+                if (begin == end) return;
+                size_t k = begin;
+                R value = hasCarry[chunk] ? carries[chunk] : R(data[idx[k]]);
+                if (!hasCarry[chunk]) {
+                    out[k++] = value;
+                }
+                for (; k < end; ++k) {
+                    if (inclusive) {
+                        value = op(value, R(data[idx[k]]));
+                        out[k] = value;
+                    } else {
+                        out[k] = value;
+                        value = op(value, R(data[idx[k]]));
+                    }
+                }
+            });
+        }
+
+        /**
+         * @brief Verifies that the output buffer can hold the whole order
+         * @throws IteratorException if out is too small
+         */
+        inline void checkOutput(size_t available, size_t needed) {
+            if (available < needed) {
+                throw IteratorException("scan output holds " + std::to_string(available) +
+                                        " values, order has " + std::to_string(needed));
+            }
+        }
+    }
+
+    /**
+     * @brief Inclusive prefix scan in the traversal order of an iterator
+     * @param order Any order (e.g. container.ascending())
+     * @param out Contiguous output range (vector, array, span); out[k] = x0 op x1 op ... op xk
+     * @param op Associative operator (default: addition)
+     * @throws IteratorException if out is smaller than the order
+     */
+    template <typename T, typename Allocator, std::ranges::contiguous_range Out, typename Op = std::plus<>>
+    void inclusive_scan(const Iterator<T, Allocator>& order, Out&& out, Op op = Op())
+    {
+        using R = std::ranges::range_value_t<Out>;
+        const typename Iterator<T, Allocator>::index_vector& idx = order.getIndices();
+        scan::checkOutput(std::ranges::size(out), idx.size());
+        scan::scanChunks(order.getContainer().data(), idx.data(), idx.size(), std::ranges::data(out), R(),
+                         op, true, parallel::chunkCount(idx.size(), scan::PARALLEL_CHUNK));
+    }
+
+    /**
+     * @brief Exclusive prefix scan in the traversal order of an iterator
+     * @param order Any order (e.g. container.ascending())
+     * @param out Contiguous output range (vector, array, span); out[0] = init,
+     *            out[k] = init op x0 op ... op x(k-1)
+     * @param init Starting value (the identity of op for plain running totals)
+     * @param op Associative operator (default: addition)
+     * @throws IteratorException if out is smaller than the order
+     */
+    template <typename T, typename Allocator, std::ranges::contiguous_range Out, typename Op = std::plus<>>
+    void exclusive_scan(const Iterator<T, Allocator>& order, Out&& out, std::ranges::range_value_t<Out> init, Op op = Op())
+    {
+        const typename Iterator<T, Allocator>::index_vector& idx = order.getIndices();
+        scan::checkOutput(std::ranges::size(out), idx.size());
+        scan::scanChunks(order.getContainer().data(), idx.data(), idx.size(), std::ranges::data(out), init,
+                         op, false, parallel::chunkCount(idx.size(), scan::PARALLEL_CHUNK));
+    }
+}
+
+#endif
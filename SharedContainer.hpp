@@ -0,0 +1,338 @@
+// galashkena1@gmail.com
+#ifndef _SHARED_CONTAINER_HPP_
+#define _SHARED_CONTAINER_HPP_
+
+#include "MyContainer.hpp"
+#include "StaticOrder.hpp"
+#include "SortEngine.hpp"
+#include <atomic>
+#include <cerrno>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace container
+{
+    /**
+     * @brief Exception thrown when a shared-memory container cannot be created, opened or modified
+     */
+    class SharedMemoryException : public std::runtime_error {
+    public:
+        SharedMemoryException(const std::string& msg) : std::runtime_error("Shared memory: " + msg) {}
+    };
+
+    /**
+     * @brief Fixed header at the start of every shared segment
+     *
+     * The loader fills in the elements and the ascending permutation, then sets
+     * published with release semantics; readers only accept a segment whose
+     * published flag they observe with acquire semantics.
+     */
+    struct SharedHeader {
+        uint64_t magic;                  ///< SHARED_MAGIC, identifies the layout
+        uint64_t element_size;           ///< sizeof(T) of the loader, checked by readers
+        uint64_t capacity;               ///< Number of element (and index) slots
+        uint64_t count;                  ///< Number of elements stored
+        std::atomic<uint32_t> published; ///< 0 while loading, 1 once the permutation is built
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                  "the published flag must be lock-free to be shared between processes");
+
+    inline constexpr uint64_t SHARED_MAGIC = 0x4d79436f6e743031ull;  // "MyCont01"
+
+    /**
+     * @brief A container whose elements and sorted permutation live in POSIX shared memory
+     *
+     * One loader process creates the segment, adds the elements and calls
+     * publish(), which builds the ascending permutation next to the elements.
+     * Any number of reader processes then open() the segment read-only and
+     * iterate all six orders through StaticOrder views, which point straight
+     * into the mapping: nothing is copied and nothing is sorted again.
+     *
+     * Segment layout (each part 64-byte aligned):
+     * | SharedHeader | T[capacity] | size_t[capacity] ascending permutation |
+     *
+     * Example:
+     *   auto shared = SharedContainer<double>::create("/prices", n);   // loader
+     *   for (double p : prices) shared.add(p);
+     *   shared.publish();
+     *   auto view = SharedContainer<double>::open("/prices");          // readers
+     *   for (double p : view.ascending()) { ... }
+     *
+     * The segment stays in the system until unlink() is called, even after
+     * every process has unmapped it.
+     *
+     * @tparam T The type of elements; must be trivially copyable and totally ordered
+     */
+    template <typename T>
+    class SharedContainer
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "SharedContainer requires a trivially copyable T");
+        static_assert(std::totally_ordered<T>, "SharedContainer requires a totally ordered T for its sorted orders");
+
+    private:
+        static constexpr size_t ALIGNMENT = 64;
+
+        std::string shm_name;     ///< Name passed to shm_open()
+        void* base = nullptr;     ///< Start of the mapping
+        size_t mapped = 0;        ///< Length of the mapping in bytes
+        bool writable = false;    ///< True for the loader, false for readers
+
+        static size_t alignUp(size_t value) {
+            return (value + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        }
+
+        static size_t dataOffset() { return alignUp(sizeof(SharedHeader)); }
+
+        static size_t permOffset(size_t capacity) { return alignUp(dataOffset() + capacity * sizeof(T)); }
+
+        static size_t segmentSize(size_t capacity) { return permOffset(capacity) + capacity * sizeof(size_t); }
+
+        static std::string systemError(const std::string& what, const std::string& name) {
+            return what + " '" + name + "' failed: " + std::strerror(errno);
+        }
+
+        SharedContainer(std::string name, void* address, size_t length, bool loader)
+            : shm_name(std::move(name)), base(address), mapped(length), writable(loader) {}
+
+        SharedHeader* header() const { return static_cast<SharedHeader*>(base); }
+
+        T* slots() const { return reinterpret_cast<T*>(static_cast<char*>(base) + dataOffset()); }
+
+        size_t* permutation() const {
+            return reinterpret_cast<size_t*>(static_cast<char*>(base) + permOffset(header()->capacity));
+        }
+
+        void release() {
+            if (base != nullptr) {
+                munmap(base, mapped);
+                base = nullptr;
+                mapped = 0;
+            }
+        }
+
+        void requireLoading() const {
+            if (!writable) throw SharedMemoryException("'" + shm_name + "' is opened read-only");
+            if (isPublished()) throw SharedMemoryException("'" + shm_name + "' is already published");
+        }
+
+    public:
+        /**
+         * @brief Creates a new shared segment for the loader process
+         * @param name Segment name, e.g. "/dataset" (see shm_open(3))
+         * @param capacity Maximum number of elements
+         * @return Writable container in the loading state
+         * @throws SharedMemoryException if the segment exists already or cannot be mapped
+         */
+        static SharedContainer create(const std::string& name, size_t capacity) {
+            int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+            if (fd < 0) throw SharedMemoryException(systemError("shm_open", name));
+
+            size_t length = segmentSize(capacity);
+            if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+                std::string msg = systemError("ftruncate", name);
+                close(fd);
+                shm_unlink(name.c_str());
+                throw SharedMemoryException(msg);
+            }
+            void* address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (address == MAP_FAILED) {
+                std::string msg = systemError("mmap", name);
+                shm_unlink(name.c_str());
+                throw SharedMemoryException(msg);
+            }
+
+            SharedHeader* h = new (address) SharedHeader{SHARED_MAGIC, sizeof(T), capacity, 0, {}};
+            h->published.store(0, std::memory_order_relaxed);
+            return SharedContainer(name, address, length, true);
+        }
+
+        /**
+         * @brief Maps an existing, published segment read-only
+         * @param name Segment name used by the loader
+         * @return Read-only container sharing the loader's elements and permutation
+         * @throws SharedMemoryException if the segment does not exist, has a
+         *         different layout or element size, or is not published yet
+         */
+        static SharedContainer open(const std::string& name) {
+            int fd = shm_open(name.c_str(), O_RDONLY, 0);
+            if (fd < 0) throw SharedMemoryException(systemError("shm_open", name));
+
+            struct stat info;
+            if (fstat(fd, &info) != 0) {
+                std::string msg = systemError("fstat", name);
+                close(fd);
+                throw SharedMemoryException(msg);
+            }
+            size_t length = static_cast<size_t>(info.st_size);
+            if (length < sizeof(SharedHeader)) {
+                close(fd);
+                throw SharedMemoryException("'" + name + "' is too small to hold a container");
+            }
+            void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            if (address == MAP_FAILED) throw SharedMemoryException(systemError("mmap", name));
+
+            SharedContainer reader(name, address, length, false);
+            const SharedHeader* h = reader.header();
+            if (h->magic != SHARED_MAGIC || h->element_size != sizeof(T) || segmentSize(h->capacity) != length) {
+                throw SharedMemoryException("'" + name + "' does not hold a container of this element type");
+            }
+            if (!reader.isPublished()) {
+                throw SharedMemoryException("'" + name + "' is not published yet");
+            }
+            return reader;
+        }
+
+        /**
+         * @brief Removes a segment name from the system
+         * @param name Segment name
+         * @return True if the segment existed
+         *
+         * Processes that still map the segment keep using it; the memory is
+         * released once the last of them unmaps it.
+         */
+        static bool unlink(const std::string& name) {
+            return shm_unlink(name.c_str()) == 0;
+        }
+
+        SharedContainer(const SharedContainer&) = delete;
+        SharedContainer& operator=(const SharedContainer&) = delete;
+
+        SharedContainer(SharedContainer&& other) noexcept
+            : shm_name(std::move(other.shm_name)), base(std::exchange(other.base, nullptr)),
+              mapped(std::exchange(other.mapped, 0)), writable(other.writable) {}
+
+        SharedContainer& operator=(SharedContainer&& other) noexcept {
+            if (this != &other) {
+                release();
+                shm_name = std::move(other.shm_name);
+                base = std::exchange(other.base, nullptr);
+                mapped = std::exchange(other.mapped, 0);
+                writable = other.writable;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Unmaps the segment (the segment itself stays until unlink())
+         */
+        ~SharedContainer() { release(); }
+
+        /**
+         * @brief Appends an element (loader only, before publish())
+         * @param element The element to add
+         * @throws SharedMemoryException if read-only, published or full
+         */
+        void add(const T& element) {
+            requireLoading();
+            SharedHeader* h = header();
+            if (h->count == h->capacity) {
+                throw SharedMemoryException("'" + shm_name + "' is full (capacity " + std::to_string(h->capacity) + ")");
+            }
+            std::memcpy(&slots()[h->count], &element, sizeof(T));
+            ++h->count;
+        }
+
+        /**
+         * @brief Builds the shared ascending permutation and makes the segment visible to readers
+         * @throws SharedMemoryException if read-only or already published
+         *
+         * This method:
+         * 1. Sorts the element positions with the same engine as MyContainer
+         *    (presorted detection, packed key/index sort for arithmetic types),
+         *    reading the elements in place in the segment
+         * 2. Writes the permutation directly into the segment
+         * 3. Sets the published flag with release semantics
+         */
+        void publish() {
+            requireLoading();
+            const size_t n = size();
+            size_t* perm = permutation();
+            std::iota(perm, perm + n, size_t(0));
+            sort_engine::sortByValues(std::span<const T>(slots(), n), perm, perm + n);
+            header()->published.store(1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Checks if the loader has published the segment
+         */
+        bool isPublished() const {
+            return header()->published.load(std::memory_order_acquire) == 1;
+        }
+
+        /**
+         * @brief Number of elements stored
+         */
+        size_t size() const { return static_cast<size_t>(header()->count); }
+
+        /**
+         * @brief Maximum number of elements
+         */
+        size_t capacity() const { return static_cast<size_t>(header()->capacity); }
+
+        /**
+         * @brief Checks if the container has no elements
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief Name of the shared segment
+         */
+        const std::string& name() const { return shm_name; }
+
+        /**
+         * @brief The elements in insertion order, read directly from the segment
+         */
+        std::span<const T> values() const { return std::span<const T>(slots(), size()); }
+
+        /**
+         * @brief The shared ascending permutation (valid once published)
+         * @throws SharedMemoryException if the segment is not published
+         */
+        std::span<const size_t> sortedIndices() const {
+            if (!isPublished()) throw SharedMemoryException("'" + shm_name + "' is not published yet");
+            return std::span<const size_t>(permutation(), size());
+        }
+
+        /**
+         * @brief Creates a read-only view in the order named by Tag
+         * @tparam Tag One of the order_tag types
+         * @return StaticOrder over the mapped elements; sorted tags use the shared permutation
+         * @throws ContainerEmptyException if the container is empty
+         * @throws SharedMemoryException for sorted tags before publish()
+         */
+        template <typename Tag>
+        StaticOrder<const T, Tag> view() const {
+            if (empty()) throw ContainerEmptyException();
+            if constexpr (order_traits<Tag>::sorted) {
+                return StaticOrder<const T, Tag>(slots(), size(), sortedIndices().data());
+            } else {
+                return StaticOrder<const T, Tag>(slots(), size());
+            }
+        }
+
+        StaticOrder<const T, order_tag::order> order() const { return view<order_tag::order>(); }
+        StaticOrder<const T, order_tag::reverse> reverse() const { return view<order_tag::reverse>(); }
+        StaticOrder<const T, order_tag::middleout> middleout() const { return view<order_tag::middleout>(); }
+        StaticOrder<const T, order_tag::ascending> ascending() const { return view<order_tag::ascending>(); }
+        StaticOrder<const T, order_tag::descending> descending() const { return view<order_tag::descending>(); }
+        StaticOrder<const T, order_tag::sidecross> sidecross() const { return view<order_tag::sidecross>(); }
+    };
+}
+
+#endif
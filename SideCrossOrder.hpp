@@ -4,6 +4,7 @@
 
 #include "MyContainer.hpp"
 #include "Iterator.hpp"
+#include "SortEngine.hpp"
 #include <algorithm>
 #include <numeric>
 
@@ -21,10 +22,14 @@ namespace container
      *          SideCross: [1, 9, 2, 8, 5] (left, right, left, right, left)
      * 
      * @tparam T The type of elements in the container
+     * @tparam Allocator Allocator of the container's storage
      */
-    template <typename T>
-    class MyContainer<T>::SideCrossOrder : public Iterator<T>
+    template <typename T, typename Allocator>
+    class MyContainer<T, Allocator>::SideCrossOrder : public Iterator<T, Allocator>
     {
+    private:
+        MyContainer<T, Allocator>& owner;  ///< Container whose maintained sorted permutation is reused
+
     public:
         /**
          * @brief Constructor that creates a side-cross order iterator
@@ -32,17 +37,41 @@ namespace container
          * 
          * Automatically calls prepareIndices() to set up the alternating traversal order.
          */
-        SideCrossOrder(MyContainer<T> &c) : Iterator<T>(c.getT())
+        SideCrossOrder(MyContainer<T, Allocator> &c) : Iterator<T, Allocator>(c.getT(), c.indexPool()), owner(c)
         {
+            static_assert(sort_engine::is_less_comparable_v<T>,
+                          "SideCrossOrder requires operator< on T - pass a key projection instead");
             prepareIndices();
         }
 
+        /**
+         * @brief Constructor that alternates between smallest and largest projected keys
+         * @param c Reference to the MyContainer to iterate over
+         * @param proj Projection that extracts the sort key (e.g. &Trade::price)
+         */
+        template <typename Proj>
+        SideCrossOrder(MyContainer<T, Allocator> &c, Proj proj) : Iterator<T, Allocator>(c.getT(), c.indexPool()), owner(c)
+        {
+            auto keys = sort_engine::extractKeys(this->original_container, proj);
+            // The sorted permutation is scratch: borrow it from the pool too and give it back
+            index_vector sortedIndices = this->borrow(this->index_pool.get(), this->indices.get_allocator());
+            const size_t n = this->original_container.size();
+            if (ContainerStats* s = c.stats_slot.get(); s && sortedIndices.capacity() < n) {
+                s->recordIndexAllocation(n * sizeof(size_t));
+            }
+            sortedIndices.resize(n);
+            std::iota(sortedIndices.begin(), sortedIndices.end(), 0);
+            sort_engine::sortByKeys(keys, sortedIndices.begin(), sortedIndices.end(), std::less<>(), c.sortKernel());
+            crossFromSorted(sortedIndices);
+            if (this->index_pool) this->index_pool->release(std::move(sortedIndices));
+        }
+
     protected:
         /**
          * @brief Prepares the indices for side-cross traversal
          * 
          * This method:
-         * 1. Creates and sorts indices based on element values
+         * 1. Takes the container's maintained ascending permutation
          * 2. Uses two pointers (left and right) on the sorted indices
          * 3. Alternates between taking from left (smallest) and right (largest)
          * 4. Continues until all elements are included
@@ -52,17 +81,22 @@ namespace container
          */
         void prepareIndices() override
         {
+            if constexpr (sort_engine::is_less_comparable_v<T>) {
+                crossFromSorted(owner.sortedIndices());
+            }
+        }
 
-            std::vector<size_t> sortedIndices(this->original_container.size());
-            std::iota(sortedIndices.begin(), sortedIndices.end(), 0);
-            
-            // Sort indices to get them in ascending order by value
-            std::sort(sortedIndices.begin(), sortedIndices.end(), 
-                [&](size_t i, size_t j) {
-                    return this->original_container[i] < this->original_container[j];
-                });
-            
+        /**
+         * @brief Fills indices by alternating between the ends of a sorted permutation
+         * @param sortedIndices Indices of the elements in ascending order
+         * 
+         * Takes sortedIndices[0], sortedIndices[n-1], sortedIndices[1], ...
+         * until the two pointers meet.
+         */
+        void crossFromSorted(const index_vector& sortedIndices)
+        {
             this->indices.clear();
+            this->indices.reserve(sortedIndices.size());
             size_t left = 0;                           
             size_t right = sortedIndices.size() - 1;   
             bool take_left = true;                     
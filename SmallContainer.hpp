@@ -0,0 +1,373 @@
+// galashkena1@gmail.com
+#ifndef _SMALL_CONTAINER_HPP_
+#define _SMALL_CONTAINER_HPP_
+
+#include "MyContainer.hpp"
+#include "StaticOrder.hpp"
+#include "SortEngine.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace container
+{
+    /**
+     * @brief Container with inline room for N elements and their sorted permutation
+     *
+     * Up to N elements live inside the object itself, next to an N-entry
+     * ascending permutation, so a small container and every traversal of it
+     * never touch the heap. Adding element N + 1 moves the elements to a
+     * std::vector (spilling) and the container keeps working on the heap
+     * from then on; clear() makes it inline again.
+     *
+     * All six orders are StaticOrder views: positional orders compute their
+     * positions and sorted orders read the inline permutation, so creating an
+     * order allocates nothing. As with MyContainer, the permutation is kept
+     * across calls: only elements added since the last sorted traversal are
+     * sorted in, and values modified through a view are detected by an O(n)
+     * check. Removal drops the permutation, which is rebuilt by the next
+     * sorted traversal.
+     *
+     * @tparam T The type of elements stored in the container
+     * @tparam N Number of elements stored inline (default 8)
+     */
+    template <typename T, size_t N = 8>
+    class SmallContainer
+    {
+        static_assert(N > 0, "SmallContainer needs room for at least one inline element");
+
+    private:
+        alignas(T) unsigned char inline_bytes[N * sizeof(T)];  ///< Raw storage for the first N elements
+        size_t inline_perm[N];           ///< Ascending permutation while the elements are inline
+        size_t count = 0;                ///< Number of elements
+        size_t sorted_count = 0;         ///< Number of leading elements covered by the permutation
+        bool spilled = false;            ///< Elements live in heap instead of inline_bytes
+        std::vector<T> heap;             ///< Storage once the container outgrew N
+        std::vector<size_t> heap_perm;   ///< Ascending permutation once the container outgrew N
+
+    public:
+        /**
+         * @brief Number of elements stored without a heap allocation
+         */
+        static constexpr size_t inline_capacity = N;
+
+        /**
+         * @brief Default constructor - creates an empty, inline container
+         */
+        SmallContainer() {}
+
+        /**
+         * @brief Copy constructor - the copy is inline if the source fits in N elements
+         * @param other Container to copy
+         */
+        SmallContainer(const SmallContainer& other) {
+            for (size_t i = 0; i < other.count; ++i) {
+                add(other.data()[i]);
+            }
+        }
+
+        /**
+         * @brief Move constructor - takes over spilled storage, moves inline elements one by one
+         * @param other Container to move from; left empty
+         */
+        SmallContainer(SmallContainer&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            takeFrom(std::move(other));
+        }
+
+        /**
+         * @brief Copy and move assignment
+         * @param other Container to copy or move from
+         * @return Reference to this container
+         */
+        SmallContainer& operator=(SmallContainer other) {
+            clear();
+            takeFrom(std::move(other));
+            return *this;
+        }
+
+        /**
+         * @brief Destroys the elements
+         */
+        ~SmallContainer() { clear(); }
+
+        /**
+         * @brief Adds an element to the end of the container
+         * @param element The element to add
+         *
+         * Spills to the heap when the container already holds N elements inline.
+         */
+        void add(const T& element) {
+            if (!spilled && count < N) {
+                new (inlineData() + count) T(element);
+                ++count;
+                return;
+            }
+            if (!spilled) {
+                spill(element);
+                return;
+            }
+            heap.push_back(element);
+            ++count;
+        }
+
+        /**
+         * @brief Removes all occurrences of the specified element from the container
+         * @param element The element to remove
+         * @throws ContainerEmptyException if the container is empty
+         * @throws ElementNotFoundException if the element is not found
+         */
+        void remove(const T& element) {
+            if (count == 0) {
+                throw ContainerEmptyException();
+            }
+            T* values = data();
+            size_t write = 0;
+            for (size_t read = 0; read < count; ++read) {
+                if (!(values[read] == element)) {
+                    if (write != read) {
+                        values[write] = std::move(values[read]);
+                    }
+                    ++write;
+                }
+            }
+            if (write == count) {
+                throw ElementNotFoundException("Value: " + describe(element));
+            }
+            if (spilled) {
+                heap.erase(heap.begin() + write, heap.end());
+            } else {
+                std::destroy(values + write, values + count);
+            }
+            count = write;
+            sorted_count = 0;
+        }
+
+        /**
+         * @brief Access element at specific index with bounds checking
+         * @param index The index of the element to access
+         * @return Reference to the element at the specified index
+         * @throws IndexOutOfBoundsException if index is invalid
+         */
+        T& at(size_t index) {
+            if (index >= count) throw IndexOutOfBoundsException(index, count);
+            return data()[index];
+        }
+
+        /**
+         * @brief Access element at specific index with bounds checking (const version)
+         * @throws IndexOutOfBoundsException if index is invalid
+         */
+        const T& at(size_t index) const {
+            if (index >= count) throw IndexOutOfBoundsException(index, count);
+            return data()[index];
+        }
+
+        /**
+         * @brief Array subscript operator with bounds checking
+         * @throws IndexOutOfBoundsException if index is invalid
+         */
+        T& operator[](size_t index) { return at(index); }
+
+        /**
+         * @brief Array subscript operator with bounds checking (const version)
+         * @throws IndexOutOfBoundsException if index is invalid
+         */
+        const T& operator[](size_t index) const { return at(index); }
+
+        /**
+         * @brief Returns the number of elements in the container
+         */
+        size_t size() const { return count; }
+
+        /**
+         * @brief Checks if the container is empty
+         */
+        bool empty() const { return count == 0; }
+
+        /**
+         * @brief Checks whether the elements are still stored inside the object
+         * @return False once the container has spilled to the heap
+         */
+        bool isInline() const { return !spilled; }
+
+        /**
+         * @brief Removes all elements and releases spilled storage, making the container inline again
+         */
+        void clear() {
+            if (spilled) {
+                std::vector<T>().swap(heap);
+                std::vector<size_t>().swap(heap_perm);
+                spilled = false;
+            } else {
+                std::destroy(inlineData(), inlineData() + count);
+            }
+            count = 0;
+            sorted_count = 0;
+        }
+
+        /**
+         * @brief The elements in insertion order
+         */
+        T* data() { return spilled ? heap.data() : inlineData(); }
+
+        /**
+         * @brief The elements in insertion order (const version)
+         */
+        const T* data() const { return spilled ? heap.data() : inlineData(); }
+
+        /**
+         * @brief The elements in insertion order as a span
+         */
+        std::span<const T> values() const { return std::span<const T>(data(), count); }
+
+        /**
+         * @brief Returns the ascending permutation of the current elements
+         * @return Span of indices i such that data()[i] visits elements from smallest to largest
+         *
+         * This method:
+         * 1. Checks the previously sorted run in O(n) - values may have been
+         *    modified through a view - and re-sorts everything if it broke
+         * 2. Sorts the elements added since the last call into the run: inline
+         *    containers with an insertion sort on the inline permutation,
+         *    spilled ones with the sort engine and a merge, like MyContainer
+         *
+         * Ties keep insertion order. The span stays valid until elements are added or removed.
+         */
+        std::span<const size_t> sortedIndices() {
+            if (spilled) heap_perm.resize(count);
+            const T* values = data();
+            size_t* perm = permData();
+            auto less = [values](size_t i, size_t j) { return values[i] < values[j]; };
+
+            if (sorted_count > count || !std::is_sorted(perm, perm + sorted_count, less)) {
+                sorted_count = 0;
+            }
+            if (sorted_count < count) {
+                std::iota(perm + sorted_count, perm + count, sorted_count);
+                if (!spilled) {
+                    // A stable insertion sort over at most N indices: new indices only
+                    // move past strictly greater elements, so ties stay in insertion order
+                    for (size_t i = std::max<size_t>(sorted_count, 1); i < count; ++i) {
+                        size_t index = perm[i];
+                        size_t j = i;
+                        for (; j > 0 && less(index, perm[j - 1]); --j) {
+                            perm[j] = perm[j - 1];
+                        }
+                        perm[j] = index;
+                    }
+                } else {
+                    sort_engine::sortByValues(heap, perm + sorted_count, perm + count);
+                    std::inplace_merge(perm, perm + sorted_count, perm + count, less);
+                }
+                sorted_count = count;
+            }
+            return std::span<const size_t>(perm, count);
+        }
+
+        /**
+         * @brief Creates a view in the order named by Tag
+         * @tparam Tag One of the order_tag types
+         * @return StaticOrder over the elements; sorted tags use the inline permutation
+         * @throws ContainerEmptyException if the container is empty
+         */
+        template <typename Tag>
+        StaticOrder<T, Tag> view() {
+            if (count == 0) throw ContainerEmptyException();
+            if constexpr (order_traits<Tag>::sorted) {
+                return StaticOrder<T, Tag>(data(), count, sortedIndices().data());
+            } else {
+                return StaticOrder<T, Tag>(data(), count);
+            }
+        }
+
+        StaticOrder<T, order_tag::order> order() { return view<order_tag::order>(); }
+        StaticOrder<T, order_tag::reverse> reverse() { return view<order_tag::reverse>(); }
+        StaticOrder<T, order_tag::middleout> middleout() { return view<order_tag::middleout>(); }
+        StaticOrder<T, order_tag::ascending> ascending() { return view<order_tag::ascending>(); }
+        StaticOrder<T, order_tag::descending> descending() { return view<order_tag::descending>(); }
+        StaticOrder<T, order_tag::sidecross> sidecross() { return view<order_tag::sidecross>(); }
+
+        /**
+         * @brief Stream output operator, in the same format as MyContainer
+         */
+        friend std::ostream& operator<<(std::ostream& os, const SmallContainer& c) {
+            os << "[";
+            for (size_t i = 0; i < c.count; ++i) {
+                os << c.data()[i];
+                if (i + 1 < c.count) os << ", ";
+            }
+            os << "]";
+            return os;
+        }
+
+    private:
+        T* inlineData() { return std::launder(reinterpret_cast<T*>(inline_bytes)); }
+        const T* inlineData() const { return std::launder(reinterpret_cast<const T*>(inline_bytes)); }
+
+        size_t* permData() { return spilled ? heap_perm.data() : inline_perm; }
+
+        /**
+         * @brief Moves the inline elements and permutation to the heap, then appends element
+         *
+         * The new storage reserves 2N elements, so the next N additions do not
+         * reallocate again. element is copied before anything is moved, since it
+         * may refer to one of the inline elements.
+         */
+        void spill(const T& element) {
+            T added(element);
+            std::vector<T> moved;
+            moved.reserve(2 * N);
+            for (size_t i = 0; i < count; ++i) {
+                moved.push_back(std::move_if_noexcept(inlineData()[i]));
+            }
+            moved.push_back(std::move(added));
+            heap_perm.reserve(2 * N);
+            heap_perm.assign(inline_perm, inline_perm + sorted_count);
+            std::destroy(inlineData(), inlineData() + count);
+            heap = std::move(moved);
+            spilled = true;
+            ++count;
+        }
+
+        /**
+         * @brief Takes the elements and permutation of other, which must be empty afterwards; this must be empty
+         */
+        void takeFrom(SmallContainer&& other) {
+            if (other.spilled) {
+                heap = std::move(other.heap);
+                heap_perm = std::move(other.heap_perm);
+                spilled = true;
+            } else {
+                for (size_t i = 0; i < other.count; ++i) {
+                    new (inlineData() + i) T(std::move(other.inlineData()[i]));
+                }
+                std::copy(other.inline_perm, other.inline_perm + other.sorted_count, inline_perm);
+            }
+            count = other.count;
+            sorted_count = other.sorted_count;
+            other.clear();
+        }
+
+        /**
+         * @brief Text used for an element in exception messages, as in MyContainer
+         */
+        static std::string describe(const T& element) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                return std::to_string(element);
+            } else if constexpr (std::is_convertible_v<const T&, std::string>) {
+                return std::string(element);
+            } else {
+                return "(unprintable element)";
+            }
+        }
+    };
+}
+
+#endif
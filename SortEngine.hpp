@@ -0,0 +1,685 @@
+// galashkena1@gmail.com
+#ifndef _SORT_ENGINE_HPP_
+#define _SORT_ENGINE_HPP_
+
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "Reductions.hpp"
+#include "StringSort.hpp"
+#include "VectorSort.hpp"
+
+namespace container
+{
+    /**
+     * @brief Sort algorithm behind the sorted orders of a container
+     *
+     * Every choice keeps the same result (ascending keys, ties by position);
+     * ranges of up to 32 elements always use the sorting networks.
+     */
+    enum class SortKernel {
+        Auto,         ///< Counting sort for integer keys of a small range, vectorized quicksort for
+                      ///< large 32/64-bit arithmetic keys, multikey quicksort for strings,
+                      ///< comparison sort otherwise
+        Comparison,   ///< std::sort over packed (key, index) pairs (or through the indices for strings)
+        Vectorized,   ///< vqsort for every supported key type, regardless of size
+        Counting      ///< Counting sort whenever the integer key range fits COUNTING_MAX_RANGE
+    };
+
+    namespace sort_engine
+    {
+        /**
+         * @brief Detects whether two T values can be compared with operator<
+         */
+        template <typename T, typename = void>
+        struct is_less_comparable : std::false_type {};
+
+        template <typename T>
+        struct is_less_comparable<T, std::void_t<decltype(std::declval<const T&>() < std::declval<const T&>())>>
+            : std::true_type {};
+
+        template <typename T>
+        inline constexpr bool is_less_comparable_v = is_less_comparable<T>::value;
+
+        /**
+         * @brief Type of the key produced by applying a projection to an element
+         * @tparam T The type of elements in the container
+         * @tparam Proj Projection (member pointer, lambda or function object)
+         */
+        template <typename T, typename Proj>
+        using projected_key_t = std::decay_t<std::invoke_result_t<Proj&, const T&>>;
+
+        /**
+         * @brief Extracts one key per element into a contiguous key column
+         * @param data The elements to project
+         * @param proj Projection applied to every element exactly once
+         * @return Vector where keys[i] is the projection of data[i]
+         *
+         * Projections are invoked with std::invoke, so pointers to data members
+         * (e.g. &Trade::price) work the same way as lambdas.
+         */
+        template <typename T, typename Alloc, typename Proj>
+        std::vector<projected_key_t<T, Proj>> extractKeys(const std::vector<T, Alloc>& data, Proj proj)
+        {
+            std::vector<projected_key_t<T, Proj>> keys;
+            keys.reserve(data.size());
+            for (const T& element : data) {
+                keys.push_back(std::invoke(proj, element));
+            }
+            return keys;
+        }
+
+        /**
+         * @brief Maximum number of natural runs merged instead of running a full sort
+         */
+        inline constexpr size_t MAX_NATURAL_RUNS = 16;
+
+        /**
+         * @brief Sorts already (or almost) ordered index ranges in O(n)
+         * @param first Begin of the index range, initially in increasing position order
+         * @param last End of the index range
+         * @param less Strict weak ordering on indices
+         * @return True if the range was sorted, false if it is not presorted enough
+         *
+         * This method:
+         * 1. Splits the range into maximal monotonic runs in a single pass
+         * 2. Reverses non-increasing runs in place, then flips every block of
+         *    equal keys back so ties keep their relative order
+         * 3. Gives up as soon as there are more than MAX_NATURAL_RUNS runs
+         * 4. Otherwise merges neighbouring runs until one is left (natural merge sort)
+         *
+         * On random data the probe stops after a few dozen elements, so the
+         * cost of trying it before a general sort is negligible.
+         */
+        template <typename IndexIt, typename Less>
+        bool sortPresorted(IndexIt first, IndexIt last, Less less)
+        {
+            if (last - first < 2) {
+                return true;
+            }
+
+            auto equal = [&](size_t i, size_t j) { return !less(i, j) && !less(j, i); };
+            std::vector<IndexIt> bounds{first};
+            IndexIt run = first;
+            while (run != last) {
+                // Equal leading keys do not decide the direction of the run
+                IndexIt next = run + 1;
+                while (next != last && equal(*next, *run)) ++next;
+                if (next != last && less(*next, *(next - 1))) {
+                    bool ties = next - run > 1;
+                    for (; next != last; ++next) {
+                        if (less(*next, *(next - 1))) continue;
+                        if (less(*(next - 1), *next)) break;
+                        ties = true;
+                    }
+                    std::reverse(run, next);
+                    for (IndexIt block = run; ties && block != next;) {
+                        IndexIt end = block + 1;
+                        while (end != next && equal(*end, *block)) ++end;
+                        std::reverse(block, end);
+                        block = end;
+                    }
+                } else {
+                    while (next != last && !less(*next, *(next - 1))) ++next;
+                }
+                bounds.push_back(next);
+                if (bounds.size() - 1 > MAX_NATURAL_RUNS) {
+                    return false;
+                }
+                run = next;
+            }
+
+            while (bounds.size() > 2) {
+                std::vector<IndexIt> merged{first};
+                for (size_t r = 0; r + 2 < bounds.size(); r += 2) {
+                    std::inplace_merge(bounds[r], bounds[r + 1], bounds[r + 2], less);
+                    merged.push_back(bounds[r + 2]);
+                }
+                if ((bounds.size() - 1) % 2 == 1) {
+                    merged.push_back(bounds.back());
+                }
+                bounds.swap(merged);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Largest range sorted by the small-size paths (sorting networks / insertion sort)
+         */
+        inline constexpr size_t SMALL_SORT_MAX = 32;
+
+        /**
+         * @brief Comparator list of Batcher's odd-even merge sort for N elements
+         *
+         * Knuth's formulation for arbitrary N, evaluated at compile time: every
+         * comparator (a, b) has a < b < N, and applying them in order sorts any
+         * input. N = 32 needs 191 comparators, N = 8 needs 19.
+         */
+        template <size_t N>
+        struct sorting_network {
+            static constexpr size_t count() {
+                size_t total = 0;
+                for (size_t p = 1; p < N; p *= 2)
+                    for (size_t k = p; k >= 1; k /= 2)
+                        for (size_t j = k % p; j + k < N; j += 2 * k)
+                            for (size_t i = 0; i < k && i + j + k < N; ++i)
+                                if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) ++total;
+                return total;
+            }
+
+            static constexpr std::array<std::pair<unsigned char, unsigned char>, count()> pairs() {
+                std::array<std::pair<unsigned char, unsigned char>, count()> list{};
+                size_t next = 0;
+                for (size_t p = 1; p < N; p *= 2)
+                    for (size_t k = p; k >= 1; k /= 2)
+                        for (size_t j = k % p; j + k < N; j += 2 * k)
+                            for (size_t i = 0; i < k && i + j + k < N; ++i)
+                                if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+                                    list[next++] = {static_cast<unsigned char>(i + j), static_cast<unsigned char>(i + j + k)};
+                return list;
+            }
+
+            static constexpr auto comparators = pairs();
+        };
+
+        /**
+         * @brief Applies every comparator of the N-element network, fully unrolled
+         * @param exchange Callable invoked as exchange(a, b) for each comparator
+         *
+         * Comparator positions become compile-time constants, so the values being
+         * sorted can stay in registers instead of being reloaded from the stack.
+         */
+        template <size_t N, typename Exchange>
+        void applyNetwork(Exchange exchange)
+        {
+            constexpr auto& comparators = sorting_network<N>::comparators;
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                (exchange(std::integral_constant<size_t, comparators[I].first>{},
+                          std::integral_constant<size_t, comparators[I].second>{}), ...);
+            }(std::make_index_sequence<comparators.size()>{});
+        }
+
+        /**
+         * @brief Calls f(std::integral_constant<size_t, n>) for a runtime n in [2, SMALL_SORT_MAX]
+         */
+        template <typename F>
+        void withSmallSize(size_t n, F f)
+        {
+            [&]<size_t... Sizes>(std::index_sequence<Sizes...>) {
+                ((n == Sizes + 2 ? (f(std::integral_constant<size_t, Sizes + 2>{}), true) : false) || ...);
+            }(std::make_index_sequence<SMALL_SORT_MAX - 1>{});
+        }
+
+        /**
+         * @brief Sorts N (key, index) pairs held in stack arrays with a sorting network
+         *
+         * Each comparator is a branchless compare-exchange: the order is decided
+         * by comp on the keys and, for equal keys, by the index, and both arrays
+         * are updated with conditional selects instead of jumps.
+         */
+        template <size_t N, typename K, typename Compare>
+        void sortNetwork(K* keys, size_t* idx, Compare comp)
+        {
+            applyNetwork<N>([&](size_t a, size_t b) {
+                K ka = keys[a], kb = keys[b];
+                size_t ia = idx[a], ib = idx[b];
+                bool exchange = comp(kb, ka) | (!comp(ka, kb) & (ib < ia));
+                keys[a] = exchange ? kb : ka;
+                keys[b] = exchange ? ka : kb;
+                idx[a] = exchange ? ib : ia;
+                idx[b] = exchange ? ia : ib;
+            });
+        }
+
+        /**
+         * @brief Keys that sortSmall() packs with their slot into one 64-bit word
+         */
+        template <typename K, typename Compare>
+        inline constexpr bool packable_key_v =
+            (std::is_integral_v<K> || std::is_same_v<K, float>) && sizeof(K) <= 4 &&
+            (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::greater<>>);
+
+        /**
+         * @brief Maps a key to an unsigned 32-bit value with the same ascending order
+         *
+         * Signed integers flip the sign bit; floats flip the sign bit of positive
+         * values and all bits of negative ones (-0.0 is treated as +0.0, as operator< does).
+         */
+        template <typename K>
+        uint32_t orderableKey(K key)
+        {
+            if constexpr (std::is_same_v<K, float>) {
+                float value = key == 0.0f ? 0.0f : key;
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+            } else if constexpr (std::is_signed_v<K>) {
+                return static_cast<uint32_t>(static_cast<int32_t>(key)) ^ 0x80000000u;
+            } else {
+                return static_cast<uint32_t>(key);
+            }
+        }
+
+        /**
+         * @brief Maps a 64-bit key to an unsigned value with the same ascending order
+         */
+        template <typename K>
+        uint64_t orderableKey64(K key)
+        {
+            if constexpr (std::is_same_v<K, double>) {
+                double value = key == 0.0 ? 0.0 : key;
+                uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+            } else if constexpr (std::is_signed_v<K>) {
+                return static_cast<uint64_t>(static_cast<int64_t>(key)) ^ 0x8000000000000000ull;
+            } else {
+                return static_cast<uint64_t>(key);
+            }
+        }
+
+        /**
+         * @brief Key types the vectorized quicksort handles (with std::less or std::greater)
+         */
+        template <typename K, typename Compare>
+        inline constexpr bool vector_sortable_v =
+            (std::is_integral_v<K> || std::is_same_v<K, float> || std::is_same_v<K, double>) &&
+            !std::is_same_v<K, bool> && sizeof(K) <= 8 &&
+            (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::greater<>>);
+
+        /**
+         * @brief Smallest range Auto hands to the vectorized quicksort
+         */
+        inline constexpr size_t VECTOR_SORT_MIN = 512;
+
+        /**
+         * @brief Sorts a range of indices by their keys with the vectorized quicksort
+         *
+         * @param index_ties True if equal keys already appear in increasing index order
+         *
+         * Keys of up to 32 bits with index_ties set are packed with their slot
+         * into one word (key << 32 | slot), so equal keys come out by index
+         * without any extra pass; everything else is sorted as (orderable key,
+         * index) pairs. Descending order complements the keys.
+         */
+        template <typename K, typename IndexIt, typename Compare>
+        void sortVectorized(std::span<const K> keys, IndexIt first, IndexIt last, Compare, bool index_ties)
+        {
+            constexpr bool descending = std::is_same_v<Compare, std::greater<>>;
+            const size_t n = static_cast<size_t>(last - first);
+            if constexpr (sizeof(K) <= 4) {
+                if (n <= UINT32_MAX && index_ties) {
+                    std::vector<uint64_t> words(n);
+                    for (size_t i = 0; i < n; ++i) {
+                        uint32_t key = orderableKey(keys[first[i]]);
+                        words[i] = (static_cast<uint64_t>(descending ? ~key : key) << 32) | i;
+                    }
+                    const size_t base = n > 0 ? static_cast<size_t>(first[0]) : 0;
+                    bool contiguous = n == 0 ||
+                        (static_cast<size_t>(first[n - 1]) - base == n - 1 && std::is_sorted(first, last));
+                    std::vector<size_t> original;
+                    if (!contiguous) original.assign(first, last);
+                    vqsort::sortWords(words.data(), n);
+                    for (size_t i = 0; i < n; ++i) {
+                        size_t slot = static_cast<uint32_t>(words[i]);
+                        first[i] = contiguous ? base + slot : original[slot];
+                    }
+                    return;
+                }
+            }
+            std::vector<uint64_t> sort_keys(n);
+            std::vector<uint64_t> positions(n);
+            for (size_t i = 0; i < n; ++i) {
+                uint64_t key;
+                if constexpr (sizeof(K) <= 4) {
+                    key = orderableKey(keys[first[i]]);
+                } else {
+                    key = orderableKey64(keys[first[i]]);
+                }
+                sort_keys[i] = descending ? ~key : key;
+                positions[i] = first[i];
+            }
+            vqsort::sortPairs(sort_keys.data(), positions.data(), n);
+            std::copy(positions.begin(), positions.end(), first);
+        }
+
+        /**
+         * @brief Largest key range (max - min + 1) a counting sort is ever run on
+         *
+         * Bounds the histogram to 4 MiB of 32-bit counters.
+         */
+        inline constexpr uint64_t COUNTING_MAX_RANGE = uint64_t(1) << 20;
+
+        /**
+         * @brief Auto counts when the key range is at most this many times the number of keys
+         */
+        inline constexpr uint64_t COUNTING_RANGE_FACTOR = 4;
+
+        /**
+         * @brief Key ranges Auto always counts, whatever the number of keys (all of uint8_t / int8_t)
+         */
+        inline constexpr uint64_t COUNTING_RANGE_FLOOR = 256;
+
+        /**
+         * @brief Key types the counting sort handles (with std::less or std::greater)
+         */
+        template <typename K, typename Compare>
+        inline constexpr bool countable_key_v =
+            std::is_integral_v<K> && !std::is_same_v<K, bool> &&
+            (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::greater<>>);
+
+        /**
+         * @brief Sorts a range of indices by small-range integer keys in O(n + range)
+         * @param keys Key column indexed by element position
+         * @param first Begin of the index range to sort
+         * @param last End of the index range to sort
+         * @param forced True to count whenever the range fits COUNTING_MAX_RANGE,
+         *        false to also require a range small relative to n (the Auto policy)
+         * @return False (and leaves the range untouched) if the keys do not qualify
+         *
+         * The sort is stable in input order, so equal keys must already appear
+         * in increasing index order for ties to resolve by index like every
+         * other path.
+         *
+         * This method:
+         * 1. Finds the key range, with the vectorized reduce::minmax() when the
+         *    range covers the whole key column
+         * 2. Declines if the range is too wide
+         * 3. Builds a histogram of keys and turns it into bucket offsets
+         * 4. Scatters the indices into their buckets in input order
+         */
+        template <typename K, typename IndexIt, typename Compare>
+        bool sortCounting(std::span<const K> keys, IndexIt first, IndexIt last, Compare, bool forced)
+        {
+            constexpr bool descending = std::is_same_v<Compare, std::greater<>>;
+            const size_t n = static_cast<size_t>(last - first);
+            if (n == 0 || n > UINT32_MAX) {
+                return false;
+            }
+
+            // Indices are distinct positions, so n == keys.size() means the whole column
+            std::pair<K, K> ends = n == keys.size() ? reduce::minmax(keys.data(), n)
+                                                    : std::pair<K, K>(keys[*first], keys[*first]);
+            K& low = ends.first;
+            K& high = ends.second;
+            if (n != keys.size()) {
+                for (IndexIt it = first; it != last; ++it) {
+                    low = std::min(low, keys[*it]);
+                    high = std::max(high, keys[*it]);
+                }
+            }
+            // Unsigned wrap-around gives the exact distance for signed keys too;
+            // a full 64-bit range wraps to 0
+            const uint64_t range = static_cast<uint64_t>(high) - static_cast<uint64_t>(low) + 1;
+            const uint64_t limit = forced ? COUNTING_MAX_RANGE
+                : std::min(COUNTING_MAX_RANGE, std::max(COUNTING_RANGE_FACTOR * n, COUNTING_RANGE_FLOOR));
+            if (range == 0 || range > limit) {
+                return false;
+            }
+
+            auto bucket = [&](K key) -> size_t {
+                return descending ? static_cast<size_t>(static_cast<uint64_t>(high) - static_cast<uint64_t>(key))
+                                  : static_cast<size_t>(static_cast<uint64_t>(key) - static_cast<uint64_t>(low));
+            };
+            std::vector<size_t> input(first, last);
+            std::vector<uint32_t> offsets(static_cast<size_t>(range), 0);
+            for (size_t index : input) {
+                ++offsets[bucket(keys[index])];
+            }
+            uint32_t total = 0;
+            for (uint32_t& count : offsets) {
+                uint32_t c = count;
+                count = total;
+                total += c;
+            }
+            for (size_t index : input) {
+                first[offsets[bucket(keys[index])]++] = index;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Key types sorted by the multikey string quicksort
+         */
+        template <typename K>
+        inline constexpr bool string_key_v = std::is_same_v<K, std::string> || std::is_same_v<K, std::string_view>;
+
+        /**
+         * @brief Sorts a range of indices by string keys with the multikey quicksort (see mkqsort)
+         * @param keys Strings indexed by element position
+         * @param first Begin of the index range to sort
+         * @param last End of the index range to sort
+         *
+         * Descending order sorts ascending, reverses the range and flips every
+         * run of equal strings back, so ties still resolve by index.
+         */
+        template <typename K, typename IndexIt, typename Compare>
+        void sortStrings(std::span<const K> keys, IndexIt first, IndexIt last, Compare)
+        {
+            mkqsort::sortIndices([&](size_t i) { return std::string_view(keys[i]); }, first, last);
+            if constexpr (std::is_same_v<Compare, std::greater<>>) {
+                std::reverse(first, last);
+                for (IndexIt run = first; run != last;) {
+                    IndexIt end = run + 1;
+                    while (end != last && keys[*end] == keys[*run]) ++end;
+                    std::reverse(run, end);
+                    run = end;
+                }
+            }
+        }
+
+        /**
+         * @brief Small-size path of sortByKeys() for ranges of at most SMALL_SORT_MAX indices
+         * @return False (and leaves the range untouched) if the range is larger
+         *
+         * Everything stays in fixed-size stack arrays, sorted by the network for
+         * exactly that size, and the indices are written back: no heap allocation
+         * and no data-dependent branches.
+         *
+         * When the keys fit in 32 bits and the indices arrive in increasing order
+         * (always the case for freshly initialized ranges), each element becomes a
+         * single word (orderable key << 32 | slot), so a comparator is one min and
+         * one max and ties still resolve by index. Otherwise (key, index) pairs
+         * are exchanged together.
+         */
+        template <typename K, typename IndexIt, typename Compare>
+        bool sortSmall(std::span<const K> keys, IndexIt first, IndexIt last, Compare comp)
+        {
+            const size_t n = static_cast<size_t>(last - first);
+            if (n > SMALL_SORT_MAX) {
+                return false;
+            }
+            size_t local_idx[SMALL_SORT_MAX];
+            std::copy(first, last, local_idx);
+
+            if constexpr (packable_key_v<K, Compare>) {
+                if (std::is_sorted(local_idx, local_idx + n)) {
+                    constexpr bool descending = std::is_same_v<Compare, std::greater<>>;
+                    uint64_t words[SMALL_SORT_MAX];
+                    for (size_t i = 0; i < n; ++i) {
+                        uint32_t key = orderableKey(keys[local_idx[i]]);
+                        words[i] = (static_cast<uint64_t>(descending ? ~key : key) << 32) | i;
+                    }
+                    withSmallSize(n, [&](auto size) {
+                        applyNetwork<size()>([&](size_t a, size_t b) {
+                            uint64_t x = words[a], y = words[b];
+                            words[a] = x < y ? x : y;
+                            words[b] = x < y ? y : x;
+                        });
+                    });
+                    for (size_t i = 0; i < n; ++i) {
+                        first[i] = local_idx[static_cast<uint32_t>(words[i])];
+                    }
+                    return true;
+                }
+            }
+
+            K local_keys[SMALL_SORT_MAX];
+            for (size_t i = 0; i < n; ++i) {
+                local_keys[i] = keys[local_idx[i]];
+            }
+            withSmallSize(n, [&](auto size) { sortNetwork<size()>(local_keys, local_idx, comp); });
+            std::copy(local_idx, local_idx + n, first);
+            return true;
+        }
+
+        /**
+         * @brief General path of sortByKeys(): presorted probe, then a counting sort,
+         *        the vectorized quicksort or a sort of packed (key, index) pairs, as kernel selects
+         */
+        template <typename K, typename IndexIt, typename Compare>
+        void sortByKeysGeneral(std::span<const K> keys, IndexIt first, IndexIt last, Compare comp,
+                               SortKernel kernel = SortKernel::Auto)
+        {
+            // The probe keeps equal keys in their relative order (it flips them back
+            // after reversing a run): if the indices start increasing, ties stay by index
+            const bool index_ties = std::is_sorted(first, last);
+            if (sortPresorted(first, last, [&](size_t i, size_t j) { return comp(keys[i], keys[j]); })) {
+                return;
+            }
+
+            if constexpr (countable_key_v<K, Compare>) {
+                if (index_ties && (kernel == SortKernel::Auto || kernel == SortKernel::Counting) &&
+                    sortCounting(keys, first, last, comp, kernel == SortKernel::Counting)) {
+                    return;
+                }
+            }
+
+            if constexpr (string_key_v<K> &&
+                          (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::greater<>>)) {
+                if (kernel != SortKernel::Comparison) {
+                    sortStrings(keys, first, last, comp);
+                    return;
+                }
+            }
+
+            if constexpr (vector_sortable_v<K, Compare>) {
+                if (kernel == SortKernel::Vectorized ||
+                    (kernel == SortKernel::Auto && static_cast<size_t>(last - first) >= VECTOR_SORT_MIN)) {
+                    sortVectorized(keys, first, last, comp, index_ties);
+                    return;
+                }
+            }
+
+            std::vector<std::pair<K, size_t>> column;
+            column.reserve(static_cast<size_t>(last - first));
+            for (IndexIt it = first; it != last; ++it) {
+                column.emplace_back(keys[*it], *it);
+            }
+
+            std::sort(column.begin(), column.end(),
+                [&](const std::pair<K, size_t>& a, const std::pair<K, size_t>& b) {
+                    if (comp(a.first, b.first)) return true;
+                    if (comp(b.first, a.first)) return false;
+                    return a.second < b.second;
+                });
+
+            for (const auto& entry : column) {
+                *first++ = entry.second;
+            }
+        }
+
+        /**
+         * @brief Sorts a range of indices by a precomputed key column
+         * @param keys Key column indexed by element position
+         * @param first Begin of the index range to sort
+         * @param last End of the index range to sort
+         * @param comp Strict weak ordering on keys (std::less for ascending)
+         *
+         * @param kernel Sort algorithm for ranges above SMALL_SORT_MAX (see SortKernel)
+         *
+         * This method:
+         * 1. Sorts ranges of up to SMALL_SORT_MAX arithmetic keys with a sorting network (see sortSmall())
+         * 2. Returns early if the keys are presorted (see sortPresorted())
+         * 3. Counts integer keys whose range is small (see sortCounting()), or
+         * 4. Sorts large 32/64-bit arithmetic keys with the vectorized quicksort (see vqsort),
+         *    or strings with the multikey quicksort (see sortStrings()), or
+         * 5. Copies (key, index) pairs for the range into one contiguous array,
+         *    sorts that array by key, breaking ties by index, and writes the
+         *    sorted indices back into [first, last)
+         *
+         * Sorting the packed pairs keeps every comparison inside one cache-friendly
+         * array instead of chasing the container for each compare.
+         */
+        template <typename K, typename IndexIt, typename Compare = std::less<>>
+        void sortByKeys(std::span<const K> keys, IndexIt first, IndexIt last, Compare comp = Compare(),
+                        SortKernel kernel = SortKernel::Auto)
+        {
+            if constexpr (std::is_arithmetic_v<K>) {
+                if (sortSmall(keys, first, last, comp)) {
+                    return;
+                }
+            }
+            sortByKeysGeneral(keys, first, last, comp, kernel);
+        }
+
+        template <typename K, typename Alloc, typename IndexIt, typename Compare = std::less<>>
+        void sortByKeys(const std::vector<K, Alloc>& keys, IndexIt first, IndexIt last, Compare comp = Compare(),
+                        SortKernel kernel = SortKernel::Auto)
+        {
+            sortByKeys(std::span<const K>(keys), first, last, comp, kernel);
+        }
+
+        /**
+         * @brief Sorts a range of indices by the values they point to
+         * @param data The elements the indices refer to
+         * @param first Begin of the index range to sort
+         * @param last End of the index range to sort
+         * @param kernel Sort algorithm for arithmetic and string values (see SortKernel)
+         *
+         * Arithmetic values are already a contiguous key column and go through
+         * sortByKeys(); strings use the multikey quicksort unless kernel is
+         * Comparison; other types are compared in place through the indices,
+         * with an insertion sort for ranges of up to SMALL_SORT_MAX indices.
+         * The comparison sort breaks ties by index, matching the other paths.
+         * data may be any contiguous storage, e.g. a shared-memory mapping.
+         */
+        template <typename T, typename IndexIt>
+        void sortByValues(std::span<const T> data, IndexIt first, IndexIt last, SortKernel kernel = SortKernel::Auto)
+        {
+            if constexpr (std::is_arithmetic_v<T>) {
+                sortByKeys(data, first, last, std::less<>(), kernel);
+            } else {
+                auto less = [&](size_t i, size_t j) { return data[i] < data[j]; };
+                if (static_cast<size_t>(last - first) <= SMALL_SORT_MAX) {
+                    // Stable insertion sort: no allocation, and few moves for tiny ranges
+                    for (IndexIt it = first + (first != last); it < last; ++it) {
+                        size_t index = *it;
+                        IndexIt hole = it;
+                        for (; hole != first && less(index, *(hole - 1)); --hole) {
+                            *hole = *(hole - 1);
+                        }
+                        *hole = index;
+                    }
+                } else if (!sortPresorted(first, last, less)) {
+                    if constexpr (string_key_v<T>) {
+                        if (kernel != SortKernel::Comparison) {
+                            sortStrings(data, first, last, std::less<>());
+                            return;
+                        }
+                    }
+                    std::sort(first, last, [&](size_t i, size_t j) {
+                        return less(i, j) || (!less(j, i) && i < j);
+                    });
+                }
+            }
+        }
+
+        template <typename T, typename Alloc, typename IndexIt>
+        void sortByValues(const std::vector<T, Alloc>& data, IndexIt first, IndexIt last, SortKernel kernel = SortKernel::Auto)
+        {
+            sortByValues(std::span<const T>(data), first, last, kernel);
+        }
+    }
+}
+
+#endif
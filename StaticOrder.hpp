@@ -0,0 +1,176 @@
+// galashkena1@gmail.com
+#ifndef _STATIC_ORDER_HPP_
+#define _STATIC_ORDER_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace container
+{
+    /**
+     * @brief Tag types naming each traversal order at compile time
+     *
+     * Passing a tag as a template argument (e.g. view<order_tag::ascending>())
+     * selects the traversal statically, so no virtual call is involved.
+     */
+    namespace order_tag
+    {
+        struct order {};       ///< Original insertion order
+        struct reverse {};     ///< Reverse insertion order
+        struct ascending {};   ///< Smallest to largest
+        struct descending {};  ///< Largest to smallest
+        struct sidecross {};   ///< Smallest, largest, second smallest, ...
+        struct middleout {};   ///< Middle position, then expanding left/right
+    }
+
+    /**
+     * @brief Maps a traversal step to an element position for a given order tag
+     *
+     * Every specialization provides:
+     * - sorted: whether the order needs the ascending permutation
+     * - index(perm, n, k): the position of the k-th visited element
+     *
+     * Positional orders compute the position in closed form and ignore perm,
+     * sorted orders read it from the ascending permutation.
+     *
+     * @tparam Tag One of the order_tag types
+     */
+    template <typename Tag>
+    struct order_traits;
+
+    template <>
+    struct order_traits<order_tag::order> {
+        static constexpr bool sorted = false;
+        static size_t index(const size_t*, size_t, size_t k) { return k; }
+    };
+
+    template <>
+    struct order_traits<order_tag::reverse> {
+        static constexpr bool sorted = false;
+        static size_t index(const size_t*, size_t n, size_t k) { return n - 1 - k; }
+    };
+
+    template <>
+    struct order_traits<order_tag::middleout> {
+        static constexpr bool sorted = false;
+        /**
+         * Step 0 is the middle (n/2), odd steps go left and even steps go right.
+         * The left side always holds at least as many elements as the right,
+         * so the alternation never has to skip an exhausted side.
+         */
+        static size_t index(const size_t*, size_t n, size_t k) {
+            size_t middle = n / 2;
+            if (k == 0) return middle;
+            return (k & 1) ? middle - (k + 1) / 2 : middle + k / 2;
+        }
+    };
+
+    template <>
+    struct order_traits<order_tag::ascending> {
+        static constexpr bool sorted = true;
+        static size_t index(const size_t* perm, size_t, size_t k) { return perm[k]; }
+    };
+
+    template <>
+    struct order_traits<order_tag::descending> {
+        static constexpr bool sorted = true;
+        static size_t index(const size_t* perm, size_t n, size_t k) { return perm[n - 1 - k]; }
+    };
+
+    template <>
+    struct order_traits<order_tag::sidecross> {
+        static constexpr bool sorted = true;
+        static size_t index(const size_t* perm, size_t n, size_t k) {
+            return (k & 1) ? perm[n - 1 - k / 2] : perm[k / 2];
+        }
+    };
+
+    /**
+     * @brief Statically dispatched, non-owning view of a container in a given order
+     *
+     * Unlike the Iterator<T> hierarchy, StaticOrder has no virtual functions and
+     * stores no index vector of its own: positional orders are computed on the fly,
+     * sorted orders borrow the ascending permutation from their owner. The whole
+     * traversal is visible to the compiler and inlines into the caller's loop.
+     *
+     * The view is invalidated by anything that invalidates the element storage
+     * or the borrowed permutation (adding or removing elements).
+     *
+     * @tparam T The type of elements (may be const-qualified for read-only views)
+     * @tparam Tag One of the order_tag types
+     */
+    template <typename T, typename Tag>
+    class StaticOrder
+    {
+    private:
+        T* data;             ///< First element of the underlying storage
+        size_t count;        ///< Number of elements
+        const size_t* perm;  ///< Ascending permutation (sorted orders only)
+
+    public:
+        /**
+         * @brief Forward iterator over the view
+         */
+        class iterator {
+        private:
+            T* data;
+            size_t count;
+            const size_t* perm;
+            size_t step;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::remove_const_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+
+            iterator() : data(nullptr), count(0), perm(nullptr), step(0) {}
+            iterator(T* d, size_t n, const size_t* p, size_t k) : data(d), count(n), perm(p), step(k) {}
+
+            T& operator*() const { return data[order_traits<Tag>::index(perm, count, step)]; }
+            T* operator->() const { return &**this; }
+            iterator& operator++() { ++step; return *this; }
+            iterator operator++(int) { iterator copy = *this; ++step; return copy; }
+            bool operator==(const iterator& other) const { return step == other.step; }
+            bool operator!=(const iterator& other) const { return step != other.step; }
+        };
+
+        /**
+         * @brief Creates a view over raw storage
+         * @param d Pointer to the first element
+         * @param n Number of elements
+         * @param p Ascending permutation of size n (required for sorted tags)
+         */
+        StaticOrder(T* d, size_t n, const size_t* p = nullptr) : data(d), count(n), perm(p) {}
+
+        iterator begin() const { return iterator(data, count, perm, 0); }
+        iterator end() const { return iterator(data, count, perm, count); }
+
+        /**
+         * @brief Number of elements visited by the view
+         */
+        size_t size() const { return count; }
+
+        /**
+         * @brief Position of the k-th visited element in the underlying storage
+         */
+        size_t indexAt(size_t k) const { return order_traits<Tag>::index(perm, count, k); }
+
+        /**
+         * @brief Applies f to every element in traversal order
+         * @param f Callable taking T&
+         *
+         * A plain counted loop with no end-of-range checks per element.
+         */
+        template <typename F>
+        void for_each(F f) const {
+            for (size_t k = 0; k < count; ++k) {
+                f(data[order_traits<Tag>::index(perm, count, k)]);
+            }
+        }
+    };
+}
+
+#endif
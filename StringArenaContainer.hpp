@@ -0,0 +1,549 @@
+// galashkena1@gmail.com
+#ifndef _STRING_ARENA_CONTAINER_HPP_
+#define _STRING_ARENA_CONTAINER_HPP_
+
+#include "MyContainer.hpp"
+#include "StaticOrder.hpp"
+#include "StringSort.hpp"
+#include "Generator.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace container
+{
+    /**
+     * @brief Exception thrown when a string arena cannot hold more bytes
+     */
+    class ArenaFullException : public std::length_error {
+    public:
+        ArenaFullException(size_t bytes)
+            : std::length_error("String arena cannot grow beyond 4 GiB (requested " + std::to_string(bytes) + " bytes)") {}
+    };
+
+    /**
+     * @brief Location of one string inside the arena
+     */
+    struct StringHandle {
+        uint32_t offset;  ///< First byte in the arena
+        uint32_t length;  ///< Number of bytes
+    };
+
+    /**
+     * @brief A container of strings whose bytes are packed into one contiguous arena
+     *
+     * MyContainer<std::string> pays one heap allocation per element (beyond the
+     * small-string buffer) and scatters the characters over the heap. Here all
+     * characters live back to back in a single byte arena and every element is
+     * an 8-byte (offset, length) handle, so adding a string is an append,
+     * clear() frees everything at once and a sort reads the bytes in roughly
+     * insertion order.
+     *
+     * With interning enabled, equal strings share one copy of their bytes: an
+     * open-addressing table from string contents to handle finds the existing
+     * copy on add(), and contains() / remove() become hash lookups that take a
+     * std::string_view and never build a std::string. Every distinct string
+     * also gets a dense id, so the sorted orders only sort the distinct strings
+     * and then place the elements by the rank of their id in O(n).
+     *
+     * Elements are read-only std::string_view values; they are invalidated by
+     * add() (the arena may move) and remove() (the arena may be compacted).
+     * The sorted orders use the multikey string sort (see mkqsort) over the
+     * arena and keep a sorted permutation up to date incrementally, like
+     * MyContainer::sortedIndices().
+     *
+     * All six orders are exposed as Generators over the string views.
+     */
+    class StringArenaContainer
+    {
+    private:
+        static constexpr size_t REMOVED = static_cast<size_t>(-1);  ///< Marks a removed position in compaction maps
+
+        /**
+         * @brief One slot of the interning table (hash 0 marks an empty slot)
+         */
+        struct InternSlot {
+            uint64_t hash;        ///< Hash of the contents, never 0 for a used slot
+            StringHandle handle;  ///< The unique copy in the arena
+            uint32_t id;          ///< Dense id of the distinct string
+        };
+
+        std::vector<char> arena;             ///< Characters of every stored string
+        std::vector<StringHandle> handles;   ///< One handle per element, in insertion order
+        bool intern_strings;                 ///< True if equal strings share their bytes
+        std::vector<InternSlot> table;       ///< Linear-probing interning table, power-of-two size (interning only)
+        size_t table_used = 0;               ///< Distinct strings in the table
+        std::vector<uint32_t> ids;           ///< Id of every element's distinct string (interning only)
+        uint32_t next_id = 0;                ///< Ids handed out so far (removed ids are not reused until compaction)
+        std::vector<StringHandle> id_handles; ///< Handle of every id (interning only; stale for removed ids)
+        std::vector<uint32_t> ranked;        ///< Ids below ranked_ids in ascending string order (interning only)
+        std::vector<uint32_t> id_rank;       ///< Position of every ranked id in ranked
+        uint32_t ranked_ids = 0;             ///< Ids covered by ranked; 0 after a removal
+        size_t garbage_bytes = 0;            ///< Arena bytes no handle refers to any more
+        std::vector<size_t> sorted_cache;    ///< Ascending permutation of the first sorted_count elements
+        size_t sorted_count = 0;             ///< Number of leading elements covered by sorted_cache
+
+        static uint64_t hashOf(std::string_view s) {
+            uint64_t h = static_cast<uint64_t>(std::hash<std::string_view>{}(s));
+            return h != 0 ? h : 1;
+        }
+
+        std::string_view viewOf(StringHandle h) const {
+            return std::string_view(arena.data() + h.offset, h.length);
+        }
+
+        /**
+         * @brief Slot holding s, or the empty slot where s would be inserted
+         *
+         * Requires a non-empty table with at least one empty slot.
+         */
+        size_t probe(std::string_view s, uint64_t hash) const {
+            const size_t mask = table.size() - 1;
+            for (size_t i = hash & mask;; i = (i + 1) & mask) {
+                const InternSlot& slot = table[i];
+                if (slot.hash == 0 || (slot.hash == hash && viewOf(slot.handle) == s)) {
+                    return i;
+                }
+            }
+        }
+
+        /**
+         * @brief The table slot of s, or nullptr if s has not been interned
+         */
+        const InternSlot* findInterned(std::string_view s) const {
+            if (table.empty()) {
+                return nullptr;
+            }
+            const InternSlot& slot = table[probe(s, hashOf(s))];
+            return slot.hash != 0 ? &slot : nullptr;
+        }
+
+        /**
+         * @brief Doubles the table (at least 16 slots), keeping it at most half full
+         */
+        void growTable() {
+            std::vector<InternSlot> old(std::max<size_t>(16, table.size() * 2), InternSlot{0, {0, 0}, 0});
+            old.swap(table);
+            const size_t mask = table.size() - 1;
+            for (const InternSlot& slot : old) {
+                if (slot.hash == 0) continue;
+                size_t i = slot.hash & mask;
+                while (table[i].hash != 0) i = (i + 1) & mask;
+                table[i] = slot;
+            }
+        }
+
+        /**
+         * @brief Empties slot i, shifting later slots of the same probe run back (no tombstones)
+         */
+        void eraseSlot(size_t i) {
+            const size_t mask = table.size() - 1;
+            for (size_t j = (i + 1) & mask; table[j].hash != 0; j = (j + 1) & mask) {
+                size_t home = table[j].hash & mask;
+                // Move slot j into the hole if its home does not lie in (i, j]
+                if (((j - home) & mask) >= ((j - i) & mask)) {
+                    table[i] = table[j];
+                    i = j;
+                }
+            }
+            table[i].hash = 0;
+            --table_used;
+        }
+
+        StringHandle append(std::string_view s) {
+            size_t offset = arena.size();
+            if (offset + s.size() > UINT32_MAX) {
+                throw ArenaFullException(offset + s.size());
+            }
+            arena.insert(arena.end(), s.begin(), s.end());
+            return StringHandle{static_cast<uint32_t>(offset), static_cast<uint32_t>(s.size())};
+        }
+
+        /**
+         * @brief Rewrites the arena without its garbage once garbage makes up half of it
+         *
+         * When interning, every distinct string is copied once, its elements are
+         * redirected to the new copy and the ids are renumbered densely.
+         */
+        void compactArenaIfWasteful() {
+            if (garbage_bytes == 0 || garbage_bytes * 2 < arena.size()) {
+                return;
+            }
+            std::vector<char> packed;
+            packed.reserve(arena.size() - garbage_bytes);
+            if (intern_strings) {
+                std::vector<uint32_t> new_id(next_id, 0);
+                std::vector<uint32_t> new_offset(next_id, 0);
+                uint32_t id = 0;
+                for (InternSlot& slot : table) {
+                    if (slot.hash == 0) continue;
+                    new_offset[slot.id] = static_cast<uint32_t>(packed.size());
+                    new_id[slot.id] = id;
+                    std::string_view bytes = viewOf(slot.handle);
+                    packed.insert(packed.end(), bytes.begin(), bytes.end());
+                    slot.handle.offset = new_offset[slot.id];
+                    slot.id = id++;
+                }
+                for (size_t k = 0; k < handles.size(); ++k) {
+                    handles[k].offset = new_offset[ids[k]];
+                    ids[k] = new_id[ids[k]];
+                }
+                next_id = id;
+                id_handles.assign(next_id, StringHandle{0, 0});
+                for (const InternSlot& slot : table) {
+                    if (slot.hash != 0) id_handles[slot.id] = slot.handle;
+                }
+            } else {
+                for (StringHandle& h : handles) {
+                    uint32_t offset = static_cast<uint32_t>(packed.size());
+                    packed.insert(packed.end(), arena.begin() + h.offset, arena.begin() + h.offset + h.length);
+                    h.offset = offset;
+                }
+            }
+            arena.swap(packed);
+            garbage_bytes = 0;
+        }
+
+        /**
+         * @brief Drops removed elements from the sorted permutation without re-sorting
+         * @param new_position Maps each old position to its new one, or REMOVED
+         */
+        void compactSortedCache(const std::vector<size_t>& new_position) {
+            if (sorted_count == 0) {
+                return;
+            }
+            size_t write = 0;
+            for (size_t k = 0; k < sorted_count; ++k) {
+                size_t moved = new_position[sorted_cache[k]];
+                if (moved != REMOVED) {
+                    sorted_cache[write++] = moved;
+                }
+            }
+            sorted_cache.resize(write);
+            sorted_count = write;
+        }
+
+        /**
+         * @brief Brings ranked and id_rank up to date with the ids handed out since the last call
+         *
+         * Only the new distinct strings are sorted (with the multikey sort) and
+         * merged into the ranked ones, so appending strings that are already
+         * interned costs nothing here. After a removal every live id is ranked
+         * again from the table.
+         */
+        void updateRanks() {
+            if (ranked_ids == next_id) {
+                return;
+            }
+            std::vector<size_t> fresh;
+            if (ranked_ids == 0) {
+                ranked.clear();
+                fresh.reserve(table_used);
+                for (const InternSlot& slot : table) {
+                    if (slot.hash != 0) fresh.push_back(slot.id);
+                }
+            } else {
+                fresh.resize(next_id - ranked_ids);
+                std::iota(fresh.begin(), fresh.end(), size_t(ranked_ids));
+            }
+            auto text = [&](size_t id) { return viewOf(id_handles[id]); };
+            mkqsort::sortIndices(text, fresh.begin(), fresh.end());
+            std::vector<uint32_t> merged(ranked.size() + fresh.size());
+            std::merge(ranked.begin(), ranked.end(), fresh.begin(), fresh.end(), merged.begin(),
+                       [&](size_t i, size_t j) { return text(i) < text(j); });
+            ranked.swap(merged);
+            id_rank.resize(next_id);
+            for (size_t r = 0; r < ranked.size(); ++r) {
+                id_rank[ranked[r]] = static_cast<uint32_t>(r);
+            }
+            ranked_ids = next_id;
+        }
+
+        /**
+         * @brief Forgets the ranks; the next sorted traversal ranks every live id again
+         */
+        void invalidateRanks() {
+            ranked.clear();
+            id_rank.clear();
+            ranked_ids = 0;
+        }
+
+        /**
+         * @brief Sorts [sorted_count, size()) into the tail of sorted_cache and merges it in (interning)
+         *
+         * A counting sort by rank: stable, so equal strings stay ordered by index.
+         */
+        void sortTailByRank() {
+            updateRanks();
+            const std::vector<uint32_t>& rank = id_rank;
+            std::vector<size_t> offsets(ranked.size() + 1, 0);
+            for (size_t i = sorted_count; i < handles.size(); ++i) {
+                ++offsets[rank[ids[i]] + 1];
+            }
+            for (size_t r = 1; r < offsets.size(); ++r) {
+                offsets[r] += offsets[r - 1];
+            }
+            for (size_t i = sorted_count; i < handles.size(); ++i) {
+                sorted_cache[sorted_count + offsets[rank[ids[i]]]++] = i;
+            }
+            if (sorted_count > 0) {
+                std::inplace_merge(sorted_cache.begin(), sorted_cache.begin() + sorted_count, sorted_cache.end(),
+                                   [&](size_t i, size_t j) { return rank[ids[i]] < rank[ids[j]]; });
+            }
+        }
+
+        void requireNonEmpty() const {
+            if (handles.empty()) throw ContainerEmptyException();
+        }
+
+        template <typename Tag>
+        Generator<const std::string_view> walk() {
+            const size_t n = size();
+            const size_t* perm = nullptr;
+            if constexpr (order_traits<Tag>::sorted) {
+                perm = sortedIndices().data();
+            }
+            for (size_t k = 0; k < n; ++k) {
+                std::string_view value = viewOf(handles[order_traits<Tag>::index(perm, n, k)]);
+                co_yield value;
+            }
+        }
+
+    public:
+        /**
+         * @brief Creates an empty container
+         * @param intern True to store equal strings only once
+         */
+        explicit StringArenaContainer(bool intern = false) : intern_strings(intern) {}
+
+        /**
+         * @brief Appends a string, copying its bytes into the arena (or reusing an interned copy)
+         * @param element The string to add
+         * @throws ArenaFullException if the arena would exceed 4 GiB
+         */
+        void add(std::string_view element) {
+            CONTAINER_TRACE_SPAN("add", handles.size());
+            if (!intern_strings) {
+                handles.push_back(append(element));
+                return;
+            }
+            if ((table_used + 1) * 2 > table.size()) {
+                growTable();
+            }
+            const uint64_t hash = hashOf(element);
+            InternSlot& slot = table[probe(element, hash)];
+            if (slot.hash == 0) {
+                slot = InternSlot{hash, append(element), next_id++};
+                id_handles.push_back(slot.handle);
+                ++table_used;
+            }
+            handles.push_back(slot.handle);
+            ids.push_back(slot.id);
+        }
+
+        /**
+         * @brief Removes all occurrences of a string
+         * @param element The string to remove (no std::string is constructed)
+         * @throws ContainerEmptyException if the container is empty
+         * @throws ElementNotFoundException if the string is not found
+         *
+         * This method:
+         * 1. Identifies the occurrences: by id when interning (one hash
+         *    lookup, then integer compares), by length and bytes otherwise
+         * 2. Compacts the handles and the sorted permutation in one pass
+         * 3. Counts the freed bytes and compacts the arena once half of it is garbage
+         */
+        void remove(std::string_view element) {
+            requireNonEmpty();
+            CONTAINER_TRACE_SPAN("remove", handles.size());
+
+            auto matches = [&](StringHandle h) { return h.length == element.size() && viewOf(h) == element; };
+            uint32_t removed_id = 0;
+            if (intern_strings) {
+                const InternSlot* slot = findInterned(element);
+                if (slot == nullptr) throw ElementNotFoundException("Value: " + std::string(element));
+                removed_id = slot->id;
+                eraseSlot(static_cast<size_t>(slot - table.data()));
+                invalidateRanks();
+                garbage_bytes += element.size();
+            } else if (std::none_of(handles.begin(), handles.end(), matches)) {
+                throw ElementNotFoundException("Value: " + std::string(element));
+            }
+
+            std::vector<size_t> new_position(sorted_count > 0 ? handles.size() : 0, REMOVED);
+            size_t write = 0;
+            for (size_t read = 0; read < handles.size(); ++read) {
+                if (intern_strings ? ids[read] == removed_id : matches(handles[read])) {
+                    if (!intern_strings) garbage_bytes += handles[read].length;
+                    continue;
+                }
+                handles[write] = handles[read];
+                if (intern_strings) ids[write] = ids[read];
+                if (!new_position.empty()) {
+                    new_position[read] = write;
+                }
+                ++write;
+            }
+            handles.resize(write);
+            if (intern_strings) ids.resize(write);
+            compactSortedCache(new_position);
+            compactArenaIfWasteful();
+        }
+
+        /**
+         * @brief Checks if a string is stored
+         * @param element The string to look for (no std::string is constructed)
+         * @return True if at least one element equals element
+         *
+         * A hash lookup when interning, otherwise a scan comparing lengths first.
+         */
+        bool contains(std::string_view element) const {
+            if (intern_strings) {
+                return findInterned(element) != nullptr;
+            }
+            return std::any_of(handles.begin(), handles.end(), [&](StringHandle h) {
+                return h.length == element.size() && viewOf(h) == element;
+            });
+        }
+
+        /**
+         * @brief Access element at specific index with bounds checking
+         * @param index The index of the element to access
+         * @return View of the element's bytes in the arena
+         * @throws IndexOutOfBoundsException if index is invalid
+         */
+        std::string_view at(size_t index) const {
+            if (index >= handles.size()) {
+                throw IndexOutOfBoundsException(index, handles.size());
+            }
+            return viewOf(handles[index]);
+        }
+
+        /**
+         * @brief Access element at specific index with bounds checking
+         * @param index The index of the element to access
+         * @return View of the element's bytes in the arena
+         * @throws IndexOutOfBoundsException if index is invalid
+         */
+        std::string_view operator[](size_t index) const { return at(index); }
+
+        /**
+         * @brief Handle of the element at index (offset and length in the arena)
+         * @throws IndexOutOfBoundsException if index is invalid
+         */
+        StringHandle handle(size_t index) const {
+            if (index >= handles.size()) {
+                throw IndexOutOfBoundsException(index, handles.size());
+            }
+            return handles[index];
+        }
+
+        /**
+         * @brief Returns the number of elements
+         */
+        size_t size() const { return handles.size(); }
+
+        /**
+         * @brief Checks if the container has no elements
+         */
+        bool empty() const { return handles.empty(); }
+
+        /**
+         * @brief Removes all elements (the arena keeps its capacity for reuse)
+         */
+        void clear() {
+            arena.clear();
+            handles.clear();
+            table.clear();
+            table_used = 0;
+            ids.clear();
+            next_id = 0;
+            id_handles.clear();
+            invalidateRanks();
+            sorted_cache.clear();
+            sorted_count = 0;
+            garbage_bytes = 0;
+        }
+
+        /**
+         * @brief Checks if equal strings share their bytes
+         */
+        bool interning() const { return intern_strings; }
+
+        /**
+         * @brief Number of distinct strings stored (interning only; otherwise size())
+         */
+        size_t uniqueCount() const { return intern_strings ? table_used : handles.size(); }
+
+        /**
+         * @brief Bytes currently held by the arena, including garbage not yet compacted
+         */
+        size_t arenaBytes() const { return arena.size(); }
+
+        /**
+         * @brief Bytes of the arena no element refers to any more
+         */
+        size_t garbageBytes() const { return garbage_bytes; }
+
+        /**
+         * @brief Returns the ascending permutation of the elements, updated incrementally
+         * @return Reference to the permutation, valid until the next add() or remove()
+         *
+         * Like MyContainer::sortedIndices(): elements added since the last call
+         * are sorted on their own and merged in; equal strings are ordered by
+         * index. When interning, the distinct strings are ranked (incrementally:
+         * only strings not seen before are sorted) and the new elements
+         * counting-sorted by rank; otherwise the new elements go through the
+         * multikey sort.
+         */
+        const std::vector<size_t>& sortedIndices() {
+            CONTAINER_TRACE_SPAN("sortedIndices", handles.size());
+            if (sorted_count == handles.size()) {
+                return sorted_cache;
+            }
+            sorted_cache.resize(handles.size());
+            if (intern_strings) {
+                sortTailByRank();
+                sorted_count = handles.size();
+                return sorted_cache;
+            }
+            auto view = [this](size_t i) { return viewOf(handles[i]); };
+            std::iota(sorted_cache.begin() + sorted_count, sorted_cache.end(), sorted_count);
+            mkqsort::sortIndices(view, sorted_cache.begin() + sorted_count, sorted_cache.end());
+            if (sorted_count > 0) {
+                std::inplace_merge(sorted_cache.begin(), sorted_cache.begin() + sorted_count, sorted_cache.end(),
+                                   [&](size_t i, size_t j) { return view(i) < view(j); });
+            }
+            sorted_count = handles.size();
+            return sorted_cache;
+        }
+
+        /**
+         * @brief Traversal in the order named by Tag
+         * @tparam Tag One of the order_tag types
+         * @throws ContainerEmptyException if the container is empty
+         */
+        template <typename Tag>
+        Generator<const std::string_view> view() {
+            requireNonEmpty();
+            return walk<Tag>();
+        }
+
+        Generator<const std::string_view> order() { return view<order_tag::order>(); }
+        Generator<const std::string_view> reverse() { return view<order_tag::reverse>(); }
+        Generator<const std::string_view> middleout() { return view<order_tag::middleout>(); }
+        Generator<const std::string_view> ascending() { return view<order_tag::ascending>(); }
+        Generator<const std::string_view> descending() { return view<order_tag::descending>(); }
+        Generator<const std::string_view> sidecross() { return view<order_tag::sidecross>(); }
+    };
+}
+
+#endif
@@ -0,0 +1,214 @@
+// galashkena1@gmail.com
+#ifndef _STRING_SORT_HPP_
+#define _STRING_SORT_HPP_
+
+#include "VectorSort.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace container
+{
+    /**
+     * @brief Multikey sort of string indices over cached 8-byte prefixes
+     *
+     * Every string is represented by the next 8 bytes at the current depth,
+     * loaded as one big-endian word, so comparing two words orders the strings
+     * exactly like std::string::operator< over those bytes. A group of strings
+     * is sorted by these words alone, with the vectorized quicksort (see vqsort)
+     * carrying each string's slot along; every run of equal words then moves on
+     * to the next 8 bytes. The strings themselves are read once per 8 bytes of
+     * depth, so shared prefixes (URLs, paths, composite keys) are never rescanned
+     * and no comparison chases a heap pointer.
+     *
+     * Ties between equal strings resolve by index.
+     */
+    namespace mkqsort
+    {
+        /**
+         * @brief Groups at most this long are finished with insertion sort
+         */
+        inline constexpr size_t INSERTION_MAX = 16;
+
+        /**
+         * @brief Bytes compared per step (one cached word)
+         */
+        inline constexpr size_t WORD_BYTES = 8;
+
+        /**
+         * @brief How many strings ahead the prefix reload prefetches string bytes
+         */
+        inline constexpr size_t PREFETCH_DISTANCE = 16;
+
+        /**
+         * @brief Where a string lives, cached so each string object is read only once
+         */
+        struct Source {
+            const char* text;  ///< Characters of the string
+            size_t length;     ///< Length of the string
+            size_t index;      ///< Position of the string in the data vector
+        };
+
+        /**
+         * @brief Loads bytes [depth, depth + 8) of a string as a big-endian word (missing bytes are 0)
+         */
+        inline uint64_t loadPrefix(const Source& source, size_t depth) {
+            if (depth >= source.length) {
+                return 0;
+            }
+            uint64_t word = 0;
+            std::memcpy(&word, source.text + depth, std::min(WORD_BYTES, source.length - depth));
+            if constexpr (std::endian::native == std::endian::little) {
+                word = __builtin_bswap64(word);
+            }
+            return word;
+        }
+
+        /**
+         * @brief Buffers shared by every group of one sort
+         */
+        struct Workspace {
+            const Source* sources;          ///< Strings by slot
+            std::vector<uint64_t> scratch_keys;
+            std::vector<uint64_t> scratch_slots;
+            vqsort::Isa isa;
+        };
+
+        /**
+         * @brief Full comparison of two strings that share their first depth bytes, ties by index
+         */
+        inline bool sourceLess(const Source& a, const Source& b, size_t depth) {
+            std::string_view x(a.text + depth, a.length - depth);
+            std::string_view y(b.text + depth, b.length - depth);
+            int c = x.compare(y);
+            return c != 0 ? c < 0 : a.index < b.index;
+        }
+
+        inline void insertionSort(uint64_t* keys, uint64_t* slots, size_t n, size_t depth, const Source* sources) {
+            for (size_t i = 1; i < n; ++i) {
+                uint64_t key = keys[i];
+                uint64_t slot = slots[i];
+                size_t j = i;
+                for (; j > 0 && (key < keys[j - 1] ||
+                                 (key == keys[j - 1] && sourceLess(sources[slot], sources[slots[j - 1]], depth)));
+                     --j) {
+                    keys[j] = keys[j - 1];
+                    slots[j] = slots[j - 1];
+                }
+                keys[j] = key;
+                slots[j] = slot;
+            }
+        }
+
+        /**
+         * @brief Sorts a group of strings that share their first depth bytes
+         * @param keys Word of each string at depth
+         * @param slots Slot (into work.sources) of each string
+         *
+         * This method:
+         * 1. Sorts the group by its words with the vectorized quicksort
+         * 2. In every run of equal words, moves the strings that end within
+         *    the word to the front (they are prefixes of the rest) and orders
+         *    them by length, then index
+         * 3. Reloads the words of the remaining strings of the run 8 bytes
+         *    deeper and sorts them as a group; the largest such group is
+         *    handled by the loop instead of recursion, so the recursion depth
+         *    stays logarithmic however long the strings are
+         */
+        inline void sortGroup(uint64_t* keys, uint64_t* slots, size_t n, size_t depth, Workspace& work) {
+            while (n > INSERTION_MAX) {
+                vqsort::sortPairsUnordered(keys, slots, n, work.scratch_keys.data(), work.scratch_slots.data(), work.isa);
+
+                size_t largest_begin = 0, largest_size = 0;
+                for (size_t run = 0; run < n;) {
+                    size_t end = run + 1;
+                    while (end < n && keys[end] == keys[run]) ++end;
+                    if (end - run > 1) {
+                        // Strings ending within this word come first. They are zero padded,
+                        // so a word whose last byte is not zero has none; strings ending
+                        // exactly at the word's end are then caught one word deeper
+                        size_t ended = run;
+                        if ((keys[run] & 0xFF) == 0) {
+                            for (size_t k = run; k < end; ++k) {
+                                if (work.sources[slots[k]].length <= depth + WORD_BYTES) {
+                                    std::swap(slots[ended++], slots[k]);
+                                }
+                            }
+                        }
+                        std::sort(slots + run, slots + ended, [&](uint64_t a, uint64_t b) {
+                            const Source& x = work.sources[a];
+                            const Source& y = work.sources[b];
+                            return x.length != y.length ? x.length < y.length : x.index < y.index;
+                        });
+
+                        // Slots are in sorted order, not memory order: prefetch the sources
+                        // two distances ahead and their characters one distance ahead
+                        for (size_t k = ended; k < end; ++k) {
+                            if (k + 2 * PREFETCH_DISTANCE < end) {
+                                __builtin_prefetch(&work.sources[slots[k + 2 * PREFETCH_DISTANCE]], 0, 3);
+                            }
+                            if (k + PREFETCH_DISTANCE < end) {
+                                __builtin_prefetch(work.sources[slots[k + PREFETCH_DISTANCE]].text + depth + WORD_BYTES, 0, 3);
+                            }
+                            keys[k] = loadPrefix(work.sources[slots[k]], depth + WORD_BYTES);
+                        }
+                        size_t remaining = end - ended;
+                        if (remaining > largest_size) {
+                            if (largest_size > 1) {
+                                sortGroup(keys + largest_begin, slots + largest_begin, largest_size,
+                                          depth + WORD_BYTES, work);
+                            }
+                            largest_begin = ended;
+                            largest_size = remaining;
+                        } else if (remaining > 1) {
+                            sortGroup(keys + ended, slots + ended, remaining, depth + WORD_BYTES, work);
+                        }
+                    }
+                    run = end;
+                }
+                if (largest_size < 2) {
+                    return;
+                }
+                keys += largest_begin;
+                slots += largest_begin;
+                n = largest_size;
+                depth += WORD_BYTES;
+            }
+            insertionSort(keys, slots, n, depth, work.sources);
+        }
+
+        /**
+         * @brief Sorts a range of indices by the strings they refer to, ascending, ties by index
+         * @param view Callable mapping an index to its string as std::string_view
+         * @param first Begin of the index range to sort
+         * @param last End of the index range to sort
+         */
+        template <typename View, typename IndexIt>
+        void sortIndices(View view, IndexIt first, IndexIt last) {
+            const size_t n = static_cast<size_t>(last - first);
+            std::vector<Source> sources(n);
+            std::vector<uint64_t> keys(n);
+            std::vector<uint64_t> slots(n);
+            for (size_t i = 0; i < n; ++i) {
+                size_t index = static_cast<size_t>(first[i]);
+                std::string_view text = view(index);
+                sources[i] = Source{text.data(), text.size(), index};
+                keys[i] = loadPrefix(sources[i], 0);
+                slots[i] = i;
+            }
+            Workspace work{sources.data(), std::vector<uint64_t>(n + vqsort::SCRATCH_PADDING),
+                           std::vector<uint64_t>(n + vqsort::SCRATCH_PADDING), vqsort::bestIsa()};
+            sortGroup(keys.data(), slots.data(), n, 0, work);
+            for (size_t i = 0; i < n; ++i) {
+                first[i] = sources[slots[i]].index;
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,331 @@
+// galashkena1@gmail.com
+#ifndef _TRACE_HPP_
+#define _TRACE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+
+#ifdef CONTAINER_TRACING
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace container
+{
+    /**
+     * @brief Span tracing of container operations, exported as Chrome trace-event JSON
+     *
+     * Build with -DCONTAINER_TRACING (make TRACE=1) to record a span for every
+     * add(), remove(), sorted-permutation update, order construction, bulk
+     * traversal and range-for walk that reaches the end of an order, together
+     * with the number of elements involved. Without the
+     * macro CONTAINER_TRACE_SPAN expands to nothing and no tracing code is
+     * compiled in.
+     *
+     * Each thread appends to its own fixed-size buffer with plain stores and one
+     * release store of the event count, so recording never locks; a mutex is only
+     * taken when a thread starts and ends recording, to take a buffer and hand it
+     * back. When a buffer is full, further events of that thread are counted as
+     * dropped.
+     *
+     * Example: container::trace::writeChromeTrace("trace.json");
+     * then load the file in chrome://tracing or https://ui.perfetto.dev.
+     */
+    namespace trace
+    {
+#ifdef CONTAINER_TRACING
+        inline constexpr bool enabled = true;
+
+        /**
+         * @brief Maximum number of spans recorded per thread
+         */
+        inline constexpr size_t BUFFER_EVENTS = size_t(1) << 16;
+
+        /**
+         * @brief One completed span
+         */
+        struct Event {
+            const char* name;      ///< Static string naming the operation
+            uint64_t start_ns;     ///< Start, in ns since the trace epoch
+            uint64_t duration_ns;  ///< Duration in ns
+            uint64_t size;         ///< Number of elements involved
+        };
+
+        /**
+         * @brief Single-producer event buffer owned by one thread at a time
+         *
+         * Only the current owner writes events; exporters read the first
+         * count events, which the release store of count makes visible.
+         */
+        struct ThreadBuffer {
+            uint32_t tid;
+            std::unique_ptr<Event[]> events{new Event[BUFFER_EVENTS]};
+            std::atomic<size_t> count{0};
+            std::atomic<size_t> dropped{0};
+
+            explicit ThreadBuffer(uint32_t id) : tid(id) {}
+
+            void record(const Event& event) {
+                size_t n = count.load(std::memory_order_relaxed);
+                if (n == BUFFER_EVENTS) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                events[n] = event;
+                count.store(n + 1, std::memory_order_release);
+            }
+        };
+
+        /**
+         * @brief Process-wide list of thread buffers and the common time origin
+         *
+         * A buffer is handed back when its thread exits and given to the next
+         * thread that starts recording, which appends after the spans already in
+         * it. Exited threads' spans therefore still appear in later exports, on
+         * the row of the buffer they were recorded in, and short-lived worker
+         * threads cost no more buffers than the most threads ever recording at
+         * once.
+         */
+        class Registry {
+        private:
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+            std::vector<ThreadBuffer*> free_buffers;  ///< Buffers of exited threads, ready for reuse
+            const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+        public:
+            static Registry& instance() {
+                static Registry registry;
+                return registry;
+            }
+
+            ThreadBuffer* acquire() {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!free_buffers.empty()) {
+                    ThreadBuffer* buffer = free_buffers.back();
+                    free_buffers.pop_back();
+                    return buffer;
+                }
+                buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(buffers.size() + 1)));
+                return buffers.back().get();
+            }
+
+            void release(ThreadBuffer* buffer) {
+                std::lock_guard<std::mutex> lock(mutex);
+                free_buffers.push_back(buffer);
+            }
+
+            size_t bufferCount() {
+                std::lock_guard<std::mutex> lock(mutex);
+                return buffers.size();
+            }
+
+            uint64_t now() const {
+                return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - epoch).count());
+            }
+
+            template <typename F>
+            void forEachBuffer(F f) {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (const auto& buffer : buffers) f(*buffer);
+            }
+        };
+
+        /**
+         * @brief Holds a thread's buffer from its first span until the thread exits
+         */
+        class BufferLease {
+        private:
+            ThreadBuffer* buffer;
+
+        public:
+            BufferLease() : buffer(Registry::instance().acquire()) {}
+            ~BufferLease() { Registry::instance().release(buffer); }
+
+            BufferLease(const BufferLease&) = delete;
+            BufferLease& operator=(const BufferLease&) = delete;
+
+            ThreadBuffer& get() const { return *buffer; }
+        };
+
+        /**
+         * @brief The calling thread's buffer, taken on first use
+         */
+        inline ThreadBuffer& localBuffer() {
+            thread_local BufferLease lease;
+            return lease.get();
+        }
+
+        /**
+         * @brief RAII span: records [construction, destruction) in the thread's buffer
+         */
+        class Span {
+        private:
+            const char* name;
+            uint64_t size;
+            uint64_t start;
+
+        public:
+            Span(const char* n, size_t elements)
+                : name(n), size(elements), start(Registry::instance().now()) {}
+
+            Span(const Span&) = delete;
+            Span& operator=(const Span&) = delete;
+
+            ~Span() {
+                uint64_t stop = Registry::instance().now();
+                localBuffer().record(Event{name, start, stop - start, size});
+            }
+        };
+
+        /**
+         * @brief Nanoseconds since the trace epoch, for spans that cannot be scoped
+         */
+        inline uint64_t now() { return Registry::instance().now(); }
+
+        /**
+         * @brief Records a span from start (a value of now()) until now
+         *
+         * For work that does not fit in one C++ scope, such as a range-for walk
+         * driven by an iterator.
+         */
+        inline void recordSince(const char* name, uint64_t start, size_t elements) {
+            uint64_t stop = Registry::instance().now();
+            localBuffer().record(Event{name, start, stop - start, elements});
+        }
+
+        /**
+         * @brief Number of spans currently recorded over all threads
+         */
+        inline size_t eventCount() {
+            size_t total = 0;
+            Registry::instance().forEachBuffer([&](ThreadBuffer& buffer) {
+                total += buffer.count.load(std::memory_order_acquire);
+            });
+            return total;
+        }
+
+        /**
+         * @brief Number of spans lost because a thread's buffer was full
+         */
+        inline size_t droppedCount() {
+            size_t total = 0;
+            Registry::instance().forEachBuffer([&](ThreadBuffer& buffer) {
+                total += buffer.dropped.load(std::memory_order_relaxed);
+            });
+            return total;
+        }
+
+        /**
+         * @brief Number of per-thread buffers allocated so far
+         *
+         * At most the number of threads that were recording at the same time.
+         */
+        inline size_t bufferCount() { return Registry::instance().bufferCount(); }
+
+        /**
+         * @brief Discards all recorded spans
+         *
+         * Must not run while other threads are recording.
+         */
+        inline void reset() {
+            Registry::instance().forEachBuffer([](ThreadBuffer& buffer) {
+                buffer.count.store(0, std::memory_order_release);
+                buffer.dropped.store(0, std::memory_order_relaxed);
+            });
+        }
+
+        /**
+         * @brief Writes all recorded spans as Chrome trace-event JSON
+         * @param out Destination stream
+         *
+         * Spans become complete ("ph":"X") events with microsecond timestamps;
+         * the element count is stored in args.n.
+         */
+        inline void exportChromeTrace(std::ostream& out) {
+            out << "{\"traceEvents\":[";
+            bool first = true;
+            Registry::instance().forEachBuffer([&](ThreadBuffer& buffer) {
+                size_t n = buffer.count.load(std::memory_order_acquire);
+                for (size_t i = 0; i < n; ++i) {
+                    const Event& event = buffer.events[i];
+                    char line[256];
+                    std::snprintf(line, sizeof(line),
+                                  "%s\n{\"name\":\"%s\",\"cat\":\"container\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                                  "\"pid\":1,\"tid\":%u,\"args\":{\"n\":%llu}}",
+                                  first ? "" : ",", event.name, event.start_ns / 1000.0, event.duration_ns / 1000.0,
+                                  buffer.tid, static_cast<unsigned long long>(event.size));
+                    out << line;
+                    first = false;
+                }
+            });
+            out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+        }
+
+        /**
+         * @brief Writes the Chrome trace-event JSON to a file
+         * @param path Output file path
+         * @return True if the file was written
+         */
+        inline bool writeChromeTrace(const std::string& path) {
+            std::ofstream file(path);
+            if (!file) return false;
+            exportChromeTrace(file);
+            return static_cast<bool>(file);
+        }
+#else
+        inline constexpr bool enabled = false;
+
+        /**
+         * @brief The document written when tracing is compiled out
+         */
+        inline constexpr const char* EMPTY_TRACE = "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n";
+
+        inline size_t eventCount() { return 0; }
+        inline size_t droppedCount() { return 0; }
+        inline size_t bufferCount() { return 0; }
+        inline void reset() {}
+        inline void exportChromeTrace(std::ostream& out) {
+            out << EMPTY_TRACE;
+        }
+
+        /**
+         * @brief Writes an empty Chrome trace-event JSON document to a file
+         * @param path Output file path
+         * @return True if the file was written
+         */
+        inline bool writeChromeTrace(const std::string& path) {
+            std::FILE* file = std::fopen(path.c_str(), "w");
+            if (file == nullptr) return false;
+            bool written = std::fputs(EMPTY_TRACE, file) >= 0;
+            return (std::fclose(file) == 0) && written;
+        }
+#endif
+    }
+}
+
+#define CONTAINER_TRACE_CONCAT_(a, b) a##b
+#define CONTAINER_TRACE_CONCAT(a, b) CONTAINER_TRACE_CONCAT_(a, b)
+
+/**
+ * @brief Records a span named name, with size elements, until the end of the enclosing scope
+ *
+ * name must be a string literal (it is stored by pointer and not escaped).
+ * Expands to nothing unless CONTAINER_TRACING is defined.
+ */
+#ifdef CONTAINER_TRACING
+#define CONTAINER_TRACE_SPAN(name, size) \
+    ::container::trace::Span CONTAINER_TRACE_CONCAT(container_trace_span_, __LINE__)((name), (size))
+#else
+#define CONTAINER_TRACE_SPAN(name, size) static_cast<void>(0)
+#endif
+
+#endif
@@ -0,0 +1,338 @@
+// galashkena1@gmail.com
+#ifndef _VECTOR_SORT_HPP_
+#define _VECTOR_SORT_HPP_
+
+#include "CpuFeatures.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#ifdef CONTAINER_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace container
+{
+    /**
+     * @brief Vectorized quicksort over 64-bit unsigned keys, optionally carrying a 64-bit value per key
+     *
+     * Each partition step streams the range once: elements below the pivot are
+     * compacted to the front of the range, the others into a scratch buffer,
+     * which is then copied behind them. With AVX-512 the compaction is a
+     * compress instruction over 8 keys, with AVX2 a lookup-table permute over 4
+     * keys; both are chosen at runtime (see cpu::hasAvx512() / cpu::hasAvx2()),
+     * and a branchless scalar loop covers other CPUs.
+     *
+     * Callers map their keys to unsigned integers with the same order first
+     * (see sort_engine::orderableKey()). Runs of equal keys are handled by
+     * splitting off all copies of the pivot when it is the smallest key, and the
+     * recursion depth is bounded: past 2*log2(n) levels the range is finished
+     * with std::sort.
+     */
+    namespace vqsort
+    {
+        /**
+         * @brief Instruction set used by the partition kernel
+         */
+        enum class Isa { Scalar, Avx2, Avx512 };
+
+        /**
+         * @brief Ranges at most this long are finished with insertion sort
+         */
+        inline constexpr size_t INSERTION_MAX = 24;
+
+        /**
+         * @brief Extra scratch slots, so vector kernels can store whole registers
+         */
+        inline constexpr size_t SCRATCH_PADDING = 8;
+
+        /**
+         * @brief Best instruction set available on this CPU
+         */
+        inline Isa bestIsa() {
+            if (cpu::hasAvx512()) return Isa::Avx512;
+            if (cpu::hasAvx2()) return Isa::Avx2;
+            return Isa::Scalar;
+        }
+
+        /**
+         * @brief Name of an instruction set, for benchmarks and logs
+         */
+        inline const char* isaName(Isa isa) {
+            switch (isa) {
+                case Isa::Avx512: return "avx512";
+                case Isa::Avx2: return "avx2";
+                default: return "scalar";
+            }
+        }
+
+        /**
+         * @brief Moves keys (and values) below bound to the front of the range
+         * @return Number of elements below bound; the others follow them
+         *
+         * Each element is written both to the front of the range and to the
+         * scratch buffer, and the write positions advance by the comparison
+         * result, so there is no branch on the data.
+         */
+        template <bool WithValues>
+        size_t partitionScalar(uint64_t* keys, uint64_t* values, size_t n, uint64_t bound,
+                               uint64_t* scratch_keys, uint64_t* scratch_values, size_t start = 0,
+                               size_t left = 0, size_t right = 0) {
+            for (size_t i = start; i < n; ++i) {
+                uint64_t key = keys[i];
+                size_t below = key < bound;
+                keys[left] = key;
+                scratch_keys[right] = key;
+                if constexpr (WithValues) {
+                    uint64_t value = values[i];
+                    values[left] = value;
+                    scratch_values[right] = value;
+                }
+                left += below;
+                right += 1 - below;
+            }
+            std::memcpy(keys + left, scratch_keys, right * sizeof(uint64_t));
+            if constexpr (WithValues) {
+                std::memcpy(values + left, scratch_values, right * sizeof(uint64_t));
+            }
+            return left;
+        }
+
+#ifdef CONTAINER_X86_SIMD
+        /**
+         * @brief permutevar8x32 indices that move the 64-bit lanes selected by a 4-bit mask to the front
+         */
+        inline constexpr std::array<std::array<int32_t, 8>, 16> COMPRESS_LUT = [] {
+            std::array<std::array<int32_t, 8>, 16> table{};
+            for (int mask = 0; mask < 16; ++mask) {
+                int out = 0;
+                for (int lane = 0; lane < 4; ++lane) {
+                    if (mask & (1 << lane)) {
+                        table[mask][2 * out] = 2 * lane;
+                        table[mask][2 * out + 1] = 2 * lane + 1;
+                        ++out;
+                    }
+                }
+                for (; out < 4; ++out) {
+                    table[mask][2 * out] = 0;
+                    table[mask][2 * out + 1] = 1;
+                }
+            }
+            return table;
+        }();
+
+        /**
+         * @brief AVX2 partition: 4 keys per step, compacted with a permute from COMPRESS_LUT
+         *
+         * Full registers are stored at the front write position, which never
+         * passes the elements already read, and into the padded scratch buffer.
+         */
+        template <bool WithValues>
+        __attribute__((target("avx2,popcnt")))
+        size_t partitionAvx2(uint64_t* keys, uint64_t* values, size_t n, uint64_t bound,
+                             uint64_t* scratch_keys, uint64_t* scratch_values) {
+            const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+            const __m256i bound_signed = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(bound)), sign);
+            size_t left = 0, right = 0, i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+                __m256i below = _mm256_cmpgt_epi64(bound_signed, _mm256_xor_si256(k, sign));
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(below)));
+                __m256i to_front = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(COMPRESS_LUT[mask].data()));
+                __m256i to_back = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(COMPRESS_LUT[mask ^ 15].data()));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys + left), _mm256_permutevar8x32_epi32(k, to_front));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(scratch_keys + right), _mm256_permutevar8x32_epi32(k, to_back));
+                if constexpr (WithValues) {
+                    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + left), _mm256_permutevar8x32_epi32(v, to_front));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(scratch_values + right), _mm256_permutevar8x32_epi32(v, to_back));
+                }
+                size_t count = static_cast<size_t>(__builtin_popcount(mask));
+                left += count;
+                right += 4 - count;
+            }
+            return partitionScalar<WithValues>(keys, values, n, bound, scratch_keys, scratch_values, i, left, right);
+        }
+
+        /**
+         * @brief AVX-512 partition: 8 keys per step, compacted with vpcompressq
+         */
+        template <bool WithValues>
+        __attribute__((target("avx512f,popcnt")))
+        size_t partitionAvx512(uint64_t* keys, uint64_t* values, size_t n, uint64_t bound,
+                               uint64_t* scratch_keys, uint64_t* scratch_values) {
+            const __m512i bound_vector = _mm512_set1_epi64(static_cast<long long>(bound));
+            size_t left = 0, right = 0, i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m512i k = _mm512_loadu_si512(keys + i);
+                __mmask8 below = _mm512_cmplt_epu64_mask(k, bound_vector);
+                __mmask8 above = static_cast<__mmask8>(~below);
+                _mm512_storeu_si512(keys + left, _mm512_maskz_compress_epi64(below, k));
+                _mm512_storeu_si512(scratch_keys + right, _mm512_maskz_compress_epi64(above, k));
+                if constexpr (WithValues) {
+                    __m512i v = _mm512_loadu_si512(values + i);
+                    _mm512_storeu_si512(values + left, _mm512_maskz_compress_epi64(below, v));
+                    _mm512_storeu_si512(scratch_values + right, _mm512_maskz_compress_epi64(above, v));
+                }
+                size_t count = static_cast<size_t>(__builtin_popcount(below));
+                left += count;
+                right += 8 - count;
+            }
+            return partitionScalar<WithValues>(keys, values, n, bound, scratch_keys, scratch_values, i, left, right);
+        }
+#endif
+
+        template <bool WithValues>
+        size_t partition(Isa isa, uint64_t* keys, uint64_t* values, size_t n, uint64_t bound,
+                         uint64_t* scratch_keys, uint64_t* scratch_values) {
+#ifdef CONTAINER_X86_SIMD
+            if (isa == Isa::Avx512) return partitionAvx512<WithValues>(keys, values, n, bound, scratch_keys, scratch_values);
+            if (isa == Isa::Avx2) return partitionAvx2<WithValues>(keys, values, n, bound, scratch_keys, scratch_values);
+#else
+            (void)isa;
+#endif
+            return partitionScalar<WithValues>(keys, values, n, bound, scratch_keys, scratch_values);
+        }
+
+        template <bool WithValues>
+        void insertionSort(uint64_t* keys, uint64_t* values, size_t n) {
+            for (size_t i = 1; i < n; ++i) {
+                uint64_t key = keys[i];
+                uint64_t value = WithValues ? values[i] : 0;
+                size_t j = i;
+                for (; j > 0 && key < keys[j - 1]; --j) {
+                    keys[j] = keys[j - 1];
+                    if constexpr (WithValues) values[j] = values[j - 1];
+                }
+                keys[j] = key;
+                if constexpr (WithValues) values[j] = value;
+            }
+        }
+
+        /**
+         * @brief Depth-limit fallback: finishes a range with std::sort
+         */
+        template <bool WithValues>
+        void fallbackSort(uint64_t* keys, uint64_t* values, size_t n) {
+            if constexpr (WithValues) {
+                std::vector<std::pair<uint64_t, uint64_t>> pairs(n);
+                for (size_t i = 0; i < n; ++i) pairs[i] = {keys[i], values[i]};
+                std::sort(pairs.begin(), pairs.end());
+                for (size_t i = 0; i < n; ++i) {
+                    keys[i] = pairs[i].first;
+                    values[i] = pairs[i].second;
+                }
+            } else {
+                std::sort(keys, keys + n);
+            }
+        }
+
+        inline uint64_t median3(uint64_t a, uint64_t b, uint64_t c) {
+            return std::max(std::min(a, b), std::min(std::max(a, b), c));
+        }
+
+        /**
+         * @brief Pivot: median of three samples, or of three medians of three (ninther) for large ranges
+         */
+        inline uint64_t choosePivot(const uint64_t* keys, size_t n) {
+            if (n < 1024) {
+                return median3(keys[n / 4], keys[n / 2], keys[3 * n / 4]);
+            }
+            size_t step = n / 8;
+            return median3(median3(keys[step], keys[2 * step], keys[3 * step]),
+                           median3(keys[3 * step + step / 2], keys[4 * step], keys[5 * step - step / 2]),
+                           median3(keys[5 * step], keys[6 * step], keys[7 * step]));
+        }
+
+        template <bool WithValues>
+        void quicksort(Isa isa, uint64_t* keys, uint64_t* values, size_t n,
+                       uint64_t* scratch_keys, uint64_t* scratch_values, int depth) {
+            while (n > INSERTION_MAX) {
+                if (depth-- == 0) {
+                    fallbackSort<WithValues>(keys, values, n);
+                    return;
+                }
+                uint64_t pivot = choosePivot(keys, n);
+                size_t left = partition<WithValues>(isa, keys, values, n, pivot, scratch_keys, scratch_values);
+                if (left == 0) {
+                    // The pivot is the smallest key: split off every copy of it
+                    if (pivot == UINT64_MAX) return;
+                    size_t equal = partition<WithValues>(isa, keys, values, n, pivot + 1, scratch_keys, scratch_values);
+                    keys += equal;
+                    if constexpr (WithValues) values += equal;
+                    n -= equal;
+                    continue;
+                }
+                // Recurse into the smaller side, loop on the larger one
+                if (left < n - left) {
+                    quicksort<WithValues>(isa, keys, values, left, scratch_keys, scratch_values, depth);
+                    keys += left;
+                    if constexpr (WithValues) values += left;
+                    n -= left;
+                } else {
+                    quicksort<WithValues>(isa, keys + left, WithValues ? values + left : values, n - left,
+                                          scratch_keys, scratch_values, depth);
+                    n = left;
+                }
+            }
+            insertionSort<WithValues>(keys, values, n);
+        }
+
+        inline int depthLimit(size_t n) {
+            int log = 0;
+            while (n > 1) {
+                n >>= 1;
+                ++log;
+            }
+            return 2 * log + 4;
+        }
+
+        /**
+         * @brief Sorts n 64-bit words in ascending order
+         * @param isa Kernel to use (defaults to the best one this CPU supports)
+         */
+        inline void sortWords(uint64_t* words, size_t n, Isa isa = bestIsa()) {
+            std::vector<uint64_t> scratch(n + SCRATCH_PADDING);
+            quicksort<false>(isa, words, nullptr, n, scratch.data(), nullptr, depthLimit(n));
+        }
+
+        /**
+         * @brief Sorts keys ascending, moving values along; equal keys end up in no particular order
+         * @param scratch_keys Buffer of at least n + SCRATCH_PADDING slots
+         * @param scratch_values Buffer of at least n + SCRATCH_PADDING slots
+         * @param isa Kernel to use
+         *
+         * For callers that sort many ranges and reuse one scratch allocation.
+         */
+        inline void sortPairsUnordered(uint64_t* keys, uint64_t* values, size_t n,
+                                       uint64_t* scratch_keys, uint64_t* scratch_values, Isa isa) {
+            quicksort<true>(isa, keys, values, n, scratch_keys, scratch_values, depthLimit(n));
+        }
+
+        /**
+         * @brief Sorts keys ascending, moving values along; equal keys end up ordered by value
+         * @param isa Kernel to use (defaults to the best one this CPU supports)
+         *
+         * Quicksort itself is not stable, so a final pass sorts the values of
+         * every run of equal keys; with distinct values (such as element
+         * positions) the result is the same as a sort by (key, value).
+         */
+        inline void sortPairs(uint64_t* keys, uint64_t* values, size_t n, Isa isa = bestIsa()) {
+            std::vector<uint64_t> scratch_keys(n + SCRATCH_PADDING);
+            std::vector<uint64_t> scratch_values(n + SCRATCH_PADDING);
+            quicksort<true>(isa, keys, values, n, scratch_keys.data(), scratch_values.data(), depthLimit(n));
+            for (size_t run = 0; run < n;) {
+                size_t end = run + 1;
+                while (end < n && keys[end] == keys[run]) ++end;
+                if (end - run > 1) std::sort(values + run, values + end);
+                run = end;
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,842 @@
+// galashkena1@gmail.com
+#include "MyContainer.hpp"
+#include "AscendingOrder.hpp"
+#include "DescendingOrder.hpp"
+#include "SideCrossOrder.hpp"
+#include "ReverseOrder.hpp"
+#include "Order.hpp"
+#include "MiddleOutOrder.hpp"
+#include "StaticOrder.hpp"
+#include "Scan.hpp"
+#include "MergedOrder.hpp"
+#include "PartitionedContainer.hpp"
+#include "StringArenaContainer.hpp"
+#include "SmallContainer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace container;
+
+// Sink that keeps the optimizer from discarding traversal loops
+static volatile long long sink = 0;
+
+template <typename F>
+double nsPerElement(size_t n, int repeats, F body) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        body();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    return ns / (static_cast<double>(n) * repeats);
+}
+
+// Every result is one long-format CSV row under the single header printed by main():
+// suite,case,type,n,metric,value ("-" where a column does not apply). Metric names
+// carry their unit (ns_per_elem, us_per_request, bytes, ...); speedups are ratios.
+static void emit(const char* suite, const std::string& case_name, const char* type, size_t n,
+                 const char* metric, double value) {
+    std::printf("%s,%s,%s,%zu,%s,%.3f\n", suite, case_name.c_str(), type, n, metric, value);
+}
+
+// Virtual Iterator<T> path: construction (prepareIndices) + traversal
+template <typename Make>
+double virtualPath(size_t n, int repeats, Make make) {
+    return nsPerElement(n, repeats, [&] {
+        long long sum = 0;
+        for (auto v : make()) sum += v;
+        sink = sink + sum;
+    });
+}
+
+// Statically dispatched StaticOrder path: view construction + traversal
+template <typename Tag>
+double staticPath(MyContainer<int>& c, int repeats) {
+    return nsPerElement(c.size(), repeats, [&] {
+        long long sum = 0;
+        for (auto v : c.view<Tag>()) sum += v;
+        sink = sink + sum;
+    });
+}
+
+static void benchStaticDispatch(size_t n, int repeats) {
+    MyContainer<int> c;
+    std::mt19937 rng(42);
+    for (size_t i = 0; i < n; ++i) c.add(static_cast<int>(rng()));
+
+    struct Row { const char* name; double virt; double stat; };
+    Row rows[] = {
+        {"order",      virtualPath(n, repeats, [&] { return c.order(); }),      staticPath<order_tag::order>(c, repeats)},
+        {"reverse",    virtualPath(n, repeats, [&] { return c.reverse(); }),    staticPath<order_tag::reverse>(c, repeats)},
+        {"middleout",  virtualPath(n, repeats, [&] { return c.middleout(); }),  staticPath<order_tag::middleout>(c, repeats)},
+        {"ascending",  virtualPath(n, repeats, [&] { return c.ascending(); }),  staticPath<order_tag::ascending>(c, repeats)},
+        {"descending", virtualPath(n, repeats, [&] { return c.descending(); }), staticPath<order_tag::descending>(c, repeats)},
+        {"sidecross",  virtualPath(n, repeats, [&] { return c.sidecross(); }),  staticPath<order_tag::sidecross>(c, repeats)},
+    };
+    for (const Row& row : rows) {
+        emit("static_dispatch", row.name, "int", n, "virtual_ns_per_elem", row.virt);
+        emit("static_dispatch", row.name, "int", n, "static_ns_per_elem", row.stat);
+        emit("static_dispatch", row.name, "int", n, "speedup", row.virt / row.stat);
+    }
+}
+
+// Sorted read after k appends: maintained permutation vs. sorting from scratch
+static void benchTailMerge(size_t n, size_t k) {
+    std::mt19937 rng(7);
+    MyContainer<int> maintained;
+    for (size_t i = 0; i < n; ++i) maintained.add(static_cast<int>(rng()));
+    maintained.sortedIndices();
+
+    std::vector<int> extra(k);
+    for (int& v : extra) v = static_cast<int>(rng());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int v : extra) maintained.add(v);
+    sink = sink + static_cast<long long>(maintained.sortedIndices().front());
+    auto mid = std::chrono::steady_clock::now();
+
+    MyContainer<int> fresh;
+    for (int v : maintained.getT()) fresh.add(v);
+    auto mid2 = std::chrono::steady_clock::now();
+    sink = sink + static_cast<long long>(fresh.sortedIndices().front());
+    auto stop = std::chrono::steady_clock::now();
+
+    double merge_ns = std::chrono::duration<double, std::nano>(mid - start).count();
+    double full_ns = std::chrono::duration<double, std::nano>(stop - mid2).count();
+    std::string appends = "appends=" + std::to_string(k);
+    emit("tail_merge", appends, "int", n + k, "full_sort_ns_per_elem", full_ns / (n + k));
+    emit("tail_merge", appends, "int", n + k, "tail_merge_ns_per_elem", merge_ns / (n + k));
+    emit("tail_merge", appends, "int", n + k, "speedup", full_ns / merge_ns);
+}
+
+// Sorted orders on already ordered data compared with the positional orders
+static void benchPresorted(size_t n, int repeats) {
+    MyContainer<int> sorted;
+    for (size_t i = 0; i < n; ++i) sorted.add(static_cast<int>(i));
+    MyContainer<int> reversed;
+    for (size_t i = n; i > 0; --i) reversed.add(static_cast<int>(i));
+
+    double order_ns = virtualPath(n, repeats, [&] { return sorted.order(); });
+    double asc_ns = nsPerElement(n, repeats, [&] {
+        sorted.clear();
+        for (size_t i = 0; i < n; ++i) sorted.add(static_cast<int>(i));
+        long long sum = 0;
+        for (auto v : sorted.ascending()) sum += v;
+        sink = sink + sum;
+    });
+    double desc_ns = nsPerElement(n, repeats, [&] {
+        reversed.clear();
+        for (size_t i = n; i > 0; --i) reversed.add(static_cast<int>(i));
+        long long sum = 0;
+        for (auto v : reversed.ascending()) sum += v;
+        sink = sink + sum;
+    });
+    emit("presorted", "order", "int", n, "ns_per_elem", order_ns);
+    emit("presorted", "ascending_on_sorted", "int", n, "ns_per_elem", asc_ns);
+    emit("presorted", "ascending_on_reversed", "int", n, "ns_per_elem", desc_ns);
+}
+
+// Ascending traversal over random data: checked iterator vs. for_each at several prefetch distances
+static void benchPrefetch(size_t n) {
+    MyContainer<int> c;
+    std::mt19937 rng(11);
+    for (size_t i = 0; i < n; ++i) c.add(static_cast<int>(rng()));
+    auto asc = c.ascending();
+    int repeats = n >= (1u << 22) ? 2 : 10;
+
+    double plain = nsPerElement(n, repeats, [&] {
+        long long sum = 0;
+        for (auto v : asc) sum += v;
+        sink = sink + sum;
+    });
+    emit("prefetch", "iterator", "int", n, "ns_per_elem", plain);
+    for (size_t distance : {0, 4, 8, 16, 32, 64}) {
+        double ns = nsPerElement(n, repeats, [&] {
+            long long sum = 0;
+            asc.for_each([&](int v) { sum += v; }, distance);
+            sink = sink + sum;
+        });
+        emit("prefetch", "distance=" + std::to_string(distance), "int", n, "ns_per_elem", ns);
+    }
+}
+
+// Copying an order out: element-by-element through custom_iterator vs. bulk gather
+template <typename V>
+static void benchMaterialize(const char* type, size_t n) {
+    MyContainer<V> c;
+    std::mt19937 rng(5);
+    for (size_t i = 0; i < n; ++i) c.add(static_cast<V>(rng() % 1000000));
+    auto asc = c.ascending();
+    std::vector<V> out(n);
+
+    double copy_ns = nsPerElement(n, 5, [&] {
+        size_t k = 0;
+        for (auto v : asc) out[k++] = v;
+        sink = sink + static_cast<long long>(out[n / 2]);
+    });
+    double gather_ns = nsPerElement(n, 5, [&] {
+        asc.materialize(out);
+        sink = sink + static_cast<long long>(out[n / 2]);
+    });
+    emit("materialize", "ascending", type, n, "iterator_copy_ns_per_elem", copy_ns);
+    emit("materialize", "ascending", type, n, "materialize_ns_per_elem", gather_ns);
+    emit("materialize", "ascending", type, n, "speedup", copy_ns / gather_ns);
+}
+
+// Aggregates: summing through order() vs. the storage-level reduction kernels
+template <typename V>
+static void benchReductions(const char* type, size_t n) {
+    MyContainer<V> c;
+    std::mt19937 rng(3);
+    for (size_t i = 0; i < n; ++i) c.add(static_cast<V>(rng() % 1000));
+
+    double loop_ns = nsPerElement(n, 5, [&] {
+        V total = 0;
+        for (auto v : c.order()) total += v;
+        sink = sink + static_cast<long long>(total);
+    });
+    double sum_ns = nsPerElement(n, 5, [&] { sink = sink + static_cast<long long>(c.sum()); });
+    double minmax_ns = nsPerElement(n, 5, [&] { sink = sink + static_cast<long long>(c.minmax().second); });
+    double variance_ns = nsPerElement(n, 5, [&] { sink = sink + static_cast<long long>(c.variance()); });
+    emit("reductions", "order_loop_sum", type, n, "ns_per_elem", loop_ns);
+    emit("reductions", "sum", type, n, "ns_per_elem", sum_ns);
+    emit("reductions", "minmax", type, n, "ns_per_elem", minmax_ns);
+    emit("reductions", "variance", type, n, "ns_per_elem", variance_ns);
+}
+
+// Running totals in ascending order: loop over ascending() vs. inclusive_scan
+static void benchScan(size_t n) {
+    MyContainer<int> c;
+    std::mt19937 rng(9);
+    for (size_t i = 0; i < n; ++i) c.add(static_cast<int>(rng() % 1000));
+    auto asc = c.ascending();
+    std::vector<long long> out(n);
+
+    double loop_ns = nsPerElement(n, 3, [&] {
+        long long running = 0;
+        size_t k = 0;
+        for (auto v : asc) out[k++] = running += v;
+        sink = sink + out[n - 1];
+    });
+    double scan_ns = nsPerElement(n, 3, [&] {
+        inclusive_scan(asc, out);
+        sink = sink + out[n - 1];
+    });
+    emit("scan", "ascending", "int", n, "iterator_loop_ns_per_elem", loop_ns);
+    emit("scan", "ascending", "int", n, "inclusive_scan_ns_per_elem", scan_ns);
+    emit("scan", "ascending", "int", n, "speedup", loop_ns / scan_ns);
+}
+
+// Sorted traversal of k containers: concatenate + ascending() vs. loser-tree merge
+static void benchMerged(size_t n, size_t k) {
+    std::mt19937 rng(13);
+    std::vector<MyContainer<int>> parts(k);
+    std::vector<MyContainer<int>*> inputs;
+    for (auto& part : parts) {
+        for (size_t i = 0; i < n / k; ++i) part.add(static_cast<int>(rng()));
+        part.sortedIndices();
+        inputs.push_back(&part);
+    }
+
+    double concat_ns = nsPerElement(n, 3, [&] {
+        MyContainer<int> all;
+        for (auto& part : parts) {
+            for (int v : part.getT()) all.add(v);
+        }
+        long long sum = 0;
+        for (auto v : all.ascending()) sum += v;
+        sink = sink + sum;
+    });
+    double merge_ns = nsPerElement(n, 3, [&] {
+        long long sum = 0;
+        for (auto v : mergedAscending(inputs)) sum += v;
+        sink = sink + sum;
+    });
+    std::string containers = "containers=" + std::to_string(k);
+    emit("merged", containers, "int", n, "concat_sort_ns_per_elem", concat_ns);
+    emit("merged", containers, "int", n, "merge_ns_per_elem", merge_ns);
+    emit("merged", containers, "int", n, "speedup", concat_ns / merge_ns);
+}
+
+// Fill + first ascending traversal: one MyContainer vs. hash and range partitions
+static void benchPartitioned(size_t n) {
+    std::mt19937 rng(17);
+    std::vector<int> values(n);
+    for (int& v : values) v = static_cast<int>(rng() % 1000000000);
+    size_t partitions = PartitionedContainer<int>::partitionsFor(n);
+    std::vector<int> splitters;
+    for (size_t p = 1; p < partitions; ++p) {
+        splitters.push_back(static_cast<int>(1000000000 / partitions * p));
+    }
+
+    double single_ns = nsPerElement(n, 1, [&] {
+        MyContainer<int> c;
+        for (int v : values) c.add(v);
+        long long sum = 0;
+        for (auto v : c.ascending()) sum += v;
+        sink = sink + sum;
+    });
+    auto partitioned = [&](PartitionedContainer<int> pc) {
+        return nsPerElement(n, 1, [&] {
+            pc.clear();
+            for (int v : values) pc.add(v);
+            long long sum = 0;
+            for (int v : pc.ascending()) sum += v;
+            sink = sink + sum;
+        });
+    };
+    double hash_ns = partitioned(PartitionedContainer<int>(partitions));
+    double range_ns = partitioned(PartitionedContainer<int>(splitters));
+    std::string parts = "partitions=" + std::to_string(partitions);
+    emit("partitioned", parts, "int", n, "single_ns_per_elem", single_ns);
+    emit("partitioned", parts, "int", n, "hash_partitioned_ns_per_elem", hash_ns);
+    emit("partitioned", parts, "int", n, "range_partitioned_ns_per_elem", range_ns);
+}
+
+// Tiny containers: sort step (general path vs. sorting network) and end-to-end
+// fill + ascending() + traversal, over millions of containers of n elements
+static void benchSmallSorts(size_t n) {
+    const size_t containers = size_t(1) << 21;
+    const size_t pool = 1024;
+    std::mt19937 rng(19);
+    std::vector<std::vector<int>> keys(pool, std::vector<int>(n));
+    for (auto& column : keys) {
+        for (int& k : column) k = static_cast<int>(rng() % 1000);
+    }
+    std::vector<size_t> idx(n);
+
+    auto sortAll = [&](auto sort) {
+        return nsPerElement(containers, 1, [&] {
+            for (size_t c = 0; c < containers; ++c) {
+                std::iota(idx.begin(), idx.end(), 0);
+                sort(keys[c % pool]);
+                sink = sink + static_cast<long long>(idx[0]);
+            }
+        });
+    };
+    double general_ns = sortAll([&](const std::vector<int>& k) {
+        sort_engine::sortByKeysGeneral(std::span<const int>(k), idx.begin(), idx.end(), std::less<>());
+    });
+    double network_ns = sortAll([&](const std::vector<int>& k) {
+        sort_engine::sortSmall(std::span<const int>(k), idx.begin(), idx.end(), std::less<>());
+    });
+
+    std::vector<MyContainer<int>> tiny(pool);
+    double container_ns = nsPerElement(containers, 1, [&] {
+        for (size_t c = 0; c < containers; ++c) {
+            MyContainer<int>& box = tiny[c % pool];
+            box.clear();
+            for (int k : keys[c % pool]) box.add(k);
+            long long sum = 0;
+            for (auto v : box.ascending()) sum += v;
+            sink = sink + sum;
+        }
+    });
+    std::string count = "containers=" + std::to_string(containers);
+    emit("small_sort", count, "int", n, "general_sort_ns_per_container", general_ns);
+    emit("small_sort", count, "int", n, "network_sort_ns_per_container", network_ns);
+    emit("small_sort", count, "int", n, "speedup", general_ns / network_ns);
+    emit("small_sort", count, "int", n, "fill_ascending_traverse_ns_per_container", container_ns);
+}
+
+// Large sorts: comparison sort of the key column vs. vectorized quicksort,
+// through sortByKeys, plus the raw word sort for every ISA the CPU supports
+template <typename K>
+static void benchVectorSort(const char* type, size_t n) {
+    std::mt19937_64 rng(44);
+    std::vector<K> keys(n);
+    for (K& k : keys) k = static_cast<K>(static_cast<int64_t>(rng() % 2000000001) - 1000000000);
+    std::vector<size_t> idx(n);
+
+    auto sortWith = [&](SortKernel kernel) {
+        return nsPerElement(n, 3, [&] {
+            std::iota(idx.begin(), idx.end(), 0);
+            sort_engine::sortByKeys(keys, idx.begin(), idx.end(), std::less<>(), kernel);
+            sink = sink + static_cast<long long>(idx[n / 2]);
+        });
+    };
+    double comparison_ns = sortWith(SortKernel::Comparison);
+    double vectorized_ns = sortWith(SortKernel::Vectorized);
+    std::string isa = std::string("isa=") + vqsort::isaName(vqsort::bestIsa());
+    emit("vector_sort", isa, type, n, "comparison_ns_per_elem", comparison_ns);
+    emit("vector_sort", isa, type, n, "vectorized_ns_per_elem", vectorized_ns);
+    emit("vector_sort", isa, type, n, "speedup", comparison_ns / vectorized_ns);
+}
+
+static void benchVectorSortIsas(size_t n) {
+    std::mt19937_64 rng(45);
+    std::vector<uint64_t> input(n), words(n);
+    for (uint64_t& w : input) w = rng();
+    for (vqsort::Isa isa : {vqsort::Isa::Scalar, vqsort::Isa::Avx2, vqsort::Isa::Avx512}) {
+        if (isa == vqsort::Isa::Avx2 && !cpu::hasAvx2()) continue;
+        if (isa == vqsort::Isa::Avx512 && !cpu::hasAvx512()) continue;
+        double ns = nsPerElement(n, 3, [&] {
+            words = input;
+            vqsort::sortWords(words.data(), n, isa);
+            sink = sink + static_cast<long long>(words[n / 2]);
+        });
+        emit("vector_sort_isa", std::string("isa=") + vqsort::isaName(isa), "uint64", n, "words_ns_per_elem", ns);
+    }
+}
+
+// Small-range integer keys: comparison and vectorized sorts vs. counting sort
+template <typename K>
+static void benchCountingSort(const char* type, size_t n, uint64_t range) {
+    std::mt19937_64 rng(45);
+    std::vector<K> keys(n);
+    for (K& k : keys) k = static_cast<K>(rng() % range);
+    std::vector<size_t> idx(n);
+
+    auto sortWith = [&](SortKernel kernel) {
+        return nsPerElement(n, 3, [&] {
+            std::iota(idx.begin(), idx.end(), 0);
+            sort_engine::sortByKeys(keys, idx.begin(), idx.end(), std::less<>(), kernel);
+            sink = sink + static_cast<long long>(idx[n / 2]);
+        });
+    };
+    double comparison_ns = sortWith(SortKernel::Comparison);
+    double vectorized_ns = sortWith(SortKernel::Vectorized);
+    double counting_ns = sortWith(SortKernel::Counting);
+    std::string key_range = "range=" + std::to_string(range);
+    emit("counting_sort", key_range, type, n, "comparison_ns_per_elem", comparison_ns);
+    emit("counting_sort", key_range, type, n, "vectorized_ns_per_elem", vectorized_ns);
+    emit("counting_sort", key_range, type, n, "counting_ns_per_elem", counting_ns);
+    emit("counting_sort", key_range, type, n, "speedup", comparison_ns / counting_ns);
+}
+
+// String containers: std::sort through the indices vs. multikey quicksort,
+// on URL-like (long shared prefixes) and key-like (fixed-width ids) data
+static void benchStringSort(const char* shape, size_t n) {
+    std::mt19937_64 rng(46);
+    std::vector<std::string> data(n);
+    const char* sections[] = {"products", "users", "orders", "search", "static/assets"};
+    for (size_t i = 0; i < n; ++i) {
+        char text[96];
+        if (std::strcmp(shape, "url") == 0) {
+            std::snprintf(text, sizeof(text), "https://www.example.com/%s/%llu?page=%llu", sections[rng() % 5],
+                          static_cast<unsigned long long>(rng() % 1000000), static_cast<unsigned long long>(rng() % 50));
+        } else {
+            std::snprintf(text, sizeof(text), "tenant-%03llu:key-%010llu", static_cast<unsigned long long>(rng() % 100),
+                          static_cast<unsigned long long>(rng() % 10000000000ull));
+        }
+        data[i] = text;
+    }
+    std::vector<size_t> idx(n);
+    auto sortWith = [&](SortKernel kernel) {
+        return nsPerElement(n, 3, [&] {
+            std::iota(idx.begin(), idx.end(), 0);
+            sort_engine::sortByValues(data, idx.begin(), idx.end(), kernel);
+            sink = sink + static_cast<long long>(idx[n / 2]);
+        });
+    };
+    double comparison_ns = sortWith(SortKernel::Comparison);
+    double multikey_ns = sortWith(SortKernel::Auto);
+    emit("string_sort", shape, "string", n, "comparison_ns_per_elem", comparison_ns);
+    emit("string_sort", shape, "string", n, "multikey_ns_per_elem", multikey_ns);
+    emit("string_sort", shape, "string", n, "speedup", comparison_ns / multikey_ns);
+}
+
+// String storage: MyContainer<std::string> vs. the arena container (plain and
+// interned) for fill, ascending() traversal and contains() lookups
+static void benchStringArena(size_t n, size_t distinct) {
+    std::mt19937_64 rng(47);
+    std::vector<std::string> input(n);
+    for (std::string& s : input) s = "session:" + std::to_string(rng() % distinct) + ":active";
+    auto time = [&](auto body) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n;
+    };
+
+    MyContainer<std::string> strings;
+    double string_fill = time([&] { for (const std::string& s : input) strings.add(s); });
+    double string_sort = time([&] {
+        size_t total = 0;
+        for (const std::string& v : strings.ascending()) total += v.size();
+        sink = sink + static_cast<long long>(total);
+    });
+
+    for (bool intern : {false, true}) {
+        StringArenaContainer arena(intern);
+        double arena_fill = time([&] { for (const std::string& s : input) arena.add(s); });
+        double arena_sort = time([&] {
+            size_t total = 0;
+            for (std::string_view v : arena.ascending()) total += v.size();
+            sink = sink + static_cast<long long>(total);
+        });
+        std::string mode = std::string(intern ? "interned" : "plain") + "/distinct=" + std::to_string(distinct);
+        emit("string_arena", mode, "string", n, "string_fill_ns_per_elem", string_fill);
+        emit("string_arena", mode, "string", n, "arena_fill_ns_per_elem", arena_fill);
+        emit("string_arena", mode, "string", n, "string_ascending_ns_per_elem", string_sort);
+        emit("string_arena", mode, "string", n, "arena_ascending_ns_per_elem", arena_sort);
+        emit("string_arena", mode, "string", n, "arena_bytes", static_cast<double>(arena.arenaBytes()));
+    }
+}
+
+// One request: build a container, walk three orders, drop everything
+static long long serveRequest(std::pmr::memory_resource* resource, const std::vector<int>& input) {
+    pmr::MyContainer<int> c(resource);
+    for (int v : input) c.add(v);
+    long long total = 0;
+    c.ascending().for_each([&](int v) { total += v; });
+    c.descending().for_each([&](int v) { total -= v; });
+    c.sidecross().for_each([&](int v) { total += v; });
+    return total;
+}
+
+static void benchMemoryResource(size_t n, int requests) {
+    std::mt19937 rng(48);
+    std::vector<int> input(n);
+    for (int& v : input) v = static_cast<int>(rng() % 1000000);
+    auto time = [&](auto body) {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < requests; ++r) body();
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / requests;
+    };
+
+    // The arena's buffer is reused by every request and released in O(1) at its end
+    std::vector<std::byte> buffer(n * 64 + 4096);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    // Alternate the two resources and keep the best of several trials, as
+    // single runs differ by more than the effect being measured
+    double heap = std::numeric_limits<double>::max();
+    double monotonic = std::numeric_limits<double>::max();
+    for (int trial = 0; trial < 5; ++trial) {
+        heap = std::min(heap, time([&] { sink = sink + serveRequest(std::pmr::get_default_resource(), input); }));
+        monotonic = std::min(monotonic, time([&] {
+            sink = sink + serveRequest(&arena, input);
+            arena.release();
+        }));
+    }
+    emit("memory_resource", "request", "int", n, "heap_us_per_request", heap);
+    emit("memory_resource", "request", "int", n, "monotonic_us_per_request", monotonic);
+    emit("memory_resource", "request", "int", n, "speedup", heap / monotonic);
+}
+
+// Re-creates every order over one container, as a loop that re-iterates would
+static void benchOrderRecreation(size_t n, int rounds) {
+    std::mt19937 rng(49);
+    MyContainer<int> c;
+    for (size_t i = 0; i < n; ++i) c.add(static_cast<int>(rng() % 1000000));
+    auto round = [&] {
+        long long total = 0;
+        c.ascending().for_each([&](int v) { total += v; });
+        c.sidecross().for_each([&](int v) { total += v; });
+        c.order().for_each([&](int v) { total += v; });
+        c.reverse().for_each([&](int v) { total += v; });
+        c.middleout().for_each([&](int v) { total += v; });
+        sink = sink + total;
+    };
+    round();
+    c.enableStats();
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) round();
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / rounds;
+    emit("order_recreation", "all_orders", "int", n, "us_per_round", us);
+    emit("order_recreation", "all_orders", "int", n, "index_allocations", static_cast<double>(c.stats().index_allocations));
+}
+
+// Many tiny containers: fill each one, then walk it in ascending order
+template <typename C>
+static void benchTinyContainers(const char* kind, size_t containers, size_t elements) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<C> all(containers);
+    for (size_t i = 0; i < containers; ++i) {
+        for (size_t k = 0; k < elements; ++k) all[i].add(static_cast<int>((i * 7 + k * 13) % 101));
+    }
+    auto filled = std::chrono::steady_clock::now();
+    long long total = 0;
+    for (C& c : all) {
+        for (int v : c.ascending()) total += v;
+    }
+    auto walked = std::chrono::steady_clock::now();
+    sink = sink + total;
+    std::string container = std::string(kind) + "/containers=" + std::to_string(containers);
+    emit("tiny_containers", container, "int", elements, "object_bytes", static_cast<double>(sizeof(C)));
+    emit("tiny_containers", container, "int", elements, "fill_ns_per_container",
+         std::chrono::duration<double, std::nano>(filled - start).count() / containers);
+    emit("tiny_containers", container, "int", elements, "ascending_ns_per_container",
+         std::chrono::duration<double, std::nano>(walked - filled).count() / containers);
+}
+
+// Focused comparisons added alongside individual optimizations
+static void runFeatureSuite() {
+    for (size_t n : {1000, 100000, 1000000}) {
+        int repeats = n >= 1000000 ? 3 : 50;
+        benchStaticDispatch(n, repeats);
+    }
+    benchTailMerge(1000000, 1000);
+    benchTailMerge(1000000, 10000);
+    benchPresorted(1000000, 3);
+    for (size_t n : {1u << 12, 1u << 16, 1u << 20, 1u << 24}) {
+        benchPrefetch(n);
+    }
+    benchMaterialize<int>("int", 1 << 20);
+    benchMaterialize<double>("double", 1 << 20);
+    benchReductions<int>("int", 1 << 22);
+    benchReductions<float>("float", 1 << 22);
+    benchReductions<double>("double", 1 << 22);
+    benchScan(1 << 22);
+    for (size_t k : {2, 8, 64}) {
+        benchMerged(1 << 20, k);
+    }
+    for (size_t n : {1u << 16, 1u << 20, 1u << 23}) {
+        benchPartitioned(n);
+    }
+    for (size_t n : {4, 8, 16, 32}) {
+        benchSmallSorts(n);
+    }
+    benchVectorSort<int>("int", 1 << 20);
+    benchVectorSort<float>("float", 1 << 20);
+    benchVectorSort<int64_t>("int64", 1 << 20);
+    benchVectorSort<double>("double", 1 << 20);
+    benchVectorSortIsas(1 << 20);
+    benchCountingSort<uint8_t>("uint8", 1 << 20, 256);
+    benchCountingSort<int16_t>("int16", 1 << 20, 65536);
+    benchCountingSort<int>("int", 1 << 20, 1000);
+    benchCountingSort<int>("int", 1 << 20, 1 << 20);
+    for (size_t n : {1u << 14, 1u << 18, 1u << 20}) {
+        benchStringSort("url", n);
+        benchStringSort("key", n);
+    }
+    benchStringArena(1 << 20, 1 << 20);
+    benchStringArena(1 << 20, 1000);
+    benchMemoryResource(100, 20000);
+    benchMemoryResource(1000, 5000);
+    benchMemoryResource(100000, 50);
+    benchOrderRecreation(1000, 5000);
+    benchOrderRecreation(100000, 100);
+    benchOrderRecreation(1000000, 10);
+    for (size_t elements : {3, 7}) {
+        benchTinyContainers<MyContainer<int>>("MyContainer", 1000000, elements);
+        benchTinyContainers<SmallContainer<int, 8>>("SmallContainer8", 1000000, elements);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Order suite: construction and traversal of all six orders, add and remove,
+// for every element type x distribution x size. One CSV row per measurement:
+// orders,<distribution>/<operation>,<type>,<n>,<phase>_ns_per_elem,<value>
+// ---------------------------------------------------------------------------
+
+struct SuiteOptions {
+    std::string suite = "all";                  // all | orders | features
+    size_t max_n = 1000000;                     // largest size (10^k steps from 10)
+    std::vector<std::string> types = {"int", "double", "string"};
+    std::vector<std::string> dists = {"random", "sorted", "reverse", "few_unique", "zipf"};
+};
+
+// Elements processed per measurement, so small sizes are repeated enough to time
+static constexpr size_t TARGET_ELEMENTS = 2000000;
+
+static size_t repeatsFor(size_t n) {
+    return std::clamp<size_t>(TARGET_ELEMENTS / n, 1, 10000);
+}
+
+// Integer keys in the requested distribution; converted to the element type afterwards
+static std::vector<uint64_t> makeKeys(const std::string& dist, size_t n) {
+    std::mt19937_64 rng(1234);
+    std::vector<uint64_t> keys(n);
+    if (dist == "sorted") {
+        for (size_t i = 0; i < n; ++i) keys[i] = i;
+    } else if (dist == "reverse") {
+        for (size_t i = 0; i < n; ++i) keys[i] = n - i;
+    } else if (dist == "few_unique") {
+        for (uint64_t& key : keys) key = rng() % 16;
+    } else if (dist == "zipf") {
+        // Zipf(s = 1.1) over min(n, 10^6) ranks, sampled by inverting the CDF
+        size_t ranks = std::max<size_t>(1, std::min<size_t>(n, 1000000));
+        std::vector<double> cdf(ranks);
+        double total = 0;
+        for (size_t r = 0; r < ranks; ++r) cdf[r] = total += 1.0 / std::pow(static_cast<double>(r + 1), 1.1);
+        std::uniform_real_distribution<double> uniform(0, total);
+        for (uint64_t& key : keys) {
+            key = static_cast<uint64_t>(std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin());
+        }
+    } else {
+        for (uint64_t& key : keys) key = rng() % 2000000000;
+    }
+    return keys;
+}
+
+template <typename V>
+V fromKey(uint64_t key);
+template <> int fromKey<int>(uint64_t key) { return static_cast<int>(key); }
+template <> double fromKey<double>(uint64_t key) { return static_cast<double>(key) * 0.5; }
+template <> std::string fromKey<std::string>(uint64_t key) { return "key-" + std::to_string(key); }
+
+static long long weight(int v) { return v; }
+static long long weight(double v) { return static_cast<long long>(v); }
+static long long weight(const std::string& v) { return static_cast<long long>(v.size()); }
+
+static double elapsedNs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::nano>(to - from).count();
+}
+
+static void printRow(const char* type, const std::string& dist, size_t n, const char* op, const char* phase, double ns) {
+    emit("orders", dist + "/" + op, type, n, (std::string(phase) + "_ns_per_elem").c_str(), ns);
+}
+
+// Times construction of an order on freshly filled containers (cold: sorted
+// orders include the sort) and one full traversal of each constructed order.
+template <typename V, typename Make>
+static void benchOrder(const char* type, const std::string& dist, const std::vector<V>& values,
+                       const char* name, Make make) {
+    using OrderType = decltype(make(std::declval<MyContainer<V>&>()));
+    const size_t n = values.size();
+    const size_t repeats = repeatsFor(n);
+    double construct_ns = 0;
+    double traverse_ns = 0;
+    for (size_t done = 0; done < repeats;) {
+        size_t batch = std::min(repeats - done, std::max<size_t>(1, TARGET_ELEMENTS / n / 4));
+        std::vector<MyContainer<V>> containers(batch);
+        for (auto& c : containers) {
+            for (const V& v : values) c.add(v);
+        }
+        std::vector<std::unique_ptr<OrderType>> orders;
+        orders.reserve(batch);
+
+        auto start = std::chrono::steady_clock::now();
+        for (auto& c : containers) orders.push_back(std::unique_ptr<OrderType>(new OrderType(make(c))));
+        auto built = std::chrono::steady_clock::now();
+        long long sum = 0;
+        for (auto& order : orders) {
+            for (const auto& v : *order) sum += weight(v);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        sink = sink + sum;
+
+        construct_ns += elapsedNs(start, built);
+        traverse_ns += elapsedNs(built, stop);
+        done += batch;
+    }
+    double elements = static_cast<double>(n) * repeats;
+    printRow(type, dist, n, name, "construct", construct_ns / elements);
+    printRow(type, dist, n, name, "traverse", traverse_ns / elements);
+}
+
+// add(): appending n elements to an empty container.
+// remove(): up to 32 calls removing the middle element's value, normalized by
+// the container size at each call (remove scans and compacts the whole storage).
+template <typename V>
+static void benchAddRemove(const char* type, const std::string& dist, const std::vector<V>& values) {
+    const size_t n = values.size();
+    const size_t repeats = repeatsFor(n);
+    double add_ns = 0;
+    double remove_ns = 0;
+    double removed_over = 0;
+    for (size_t r = 0; r < repeats; ++r) {
+        MyContainer<V> c;
+        auto start = std::chrono::steady_clock::now();
+        for (const V& v : values) c.add(v);
+        auto stop = std::chrono::steady_clock::now();
+        add_ns += elapsedNs(start, stop);
+
+        if (r < std::max<size_t>(1, repeats / 8)) {
+            for (int call = 0; call < 32 && !c.empty(); ++call) {
+                V victim = c[c.size() / 2];
+                removed_over += static_cast<double>(c.size());
+                auto before = std::chrono::steady_clock::now();
+                c.remove(victim);
+                remove_ns += elapsedNs(before, std::chrono::steady_clock::now());
+            }
+        }
+    }
+    printRow(type, dist, n, "add", "total", add_ns / (static_cast<double>(n) * repeats));
+    printRow(type, dist, n, "remove", "total", remove_ns / removed_over);
+}
+
+template <typename V>
+static void runOrderSuiteFor(const char* type, const SuiteOptions& options) {
+    for (const std::string& dist : options.dists) {
+        for (size_t n = 10; n <= options.max_n; n *= 10) {
+            std::vector<uint64_t> keys = makeKeys(dist, n);
+            std::vector<V> values;
+            values.reserve(n);
+            for (uint64_t key : keys) values.push_back(fromKey<V>(key));
+            keys = {};
+
+            benchOrder(type, dist, values, "order",      [](MyContainer<V>& c) { return c.order(); });
+            benchOrder(type, dist, values, "reverse",    [](MyContainer<V>& c) { return c.reverse(); });
+            benchOrder(type, dist, values, "middleout",  [](MyContainer<V>& c) { return c.middleout(); });
+            benchOrder(type, dist, values, "ascending",  [](MyContainer<V>& c) { return c.ascending(); });
+            benchOrder(type, dist, values, "descending", [](MyContainer<V>& c) { return c.descending(); });
+            benchOrder(type, dist, values, "sidecross",  [](MyContainer<V>& c) { return c.sidecross(); });
+            benchAddRemove(type, dist, values);
+            std::fflush(stdout);
+        }
+    }
+}
+
+static void runOrderSuite(const SuiteOptions& options) {
+    for (const std::string& type : options.types) {
+        if (type == "int") runOrderSuiteFor<int>("int", options);
+        else if (type == "double") runOrderSuiteFor<double>("double", options);
+        else if (type == "string") runOrderSuiteFor<std::string>("string", options);
+        else std::fprintf(stderr, "bench: unknown type '%s' skipped\n", type.c_str());
+    }
+}
+
+static std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    size_t begin = 0;
+    while (begin <= text.size()) {
+        size_t end = text.find(',', begin);
+        if (end == std::string::npos) end = text.size();
+        if (end > begin) items.push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return items;
+}
+
+// Options come from BENCH_SUITE / BENCH_MAX_N / BENCH_TYPES / BENCH_DISTS,
+// overridden by --suite= / --max-n= / --types= / --dists= arguments.
+static SuiteOptions parseOptions(int argc, char** argv) {
+    SuiteOptions options;
+    auto apply = [&](const std::string& key, const std::string& value) {
+        if (key == "suite") options.suite = value;
+        else if (key == "max-n") options.max_n = std::max<size_t>(10, std::strtoull(value.c_str(), nullptr, 10));
+        else if (key == "types") options.types = splitList(value);
+        else if (key == "dists") options.dists = splitList(value);
+        else std::fprintf(stderr, "bench: unknown option '%s' ignored\n", key.c_str());
+    };
+    const char* env_names[][2] = {{"BENCH_SUITE", "suite"}, {"BENCH_MAX_N", "max-n"},
+                                  {"BENCH_TYPES", "types"}, {"BENCH_DISTS", "dists"}};
+    for (auto& [env, key] : env_names) {
+        if (const char* value = std::getenv(env)) apply(key, value);
+    }
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            std::fprintf(stderr, "usage: %s [--suite=all|orders|features] [--max-n=N] "
+                                 "[--types=int,double,string] [--dists=random,sorted,reverse,few_unique,zipf]\n", argv[0]);
+            std::exit(2);
+        }
+        apply(arg.substr(2, eq - 2), arg.substr(eq + 1));
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    SuiteOptions options = parseOptions(argc, argv);
+    std::printf("suite,case,type,n,metric,value\n");
+    if (options.suite == "all" || options.suite == "orders") {
+        runOrderSuite(options);
+    }
+    if (options.suite == "all" || options.suite == "features") {
+        runFeatureSuite();
+    }
+    return 0;
+}
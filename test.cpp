@@ -8,10 +8,32 @@
 #include "ReverseOrder.hpp"
 #include "Order.hpp"
 #include "MiddleOutOrder.hpp"
+#include "StaticOrder.hpp"
+#include "OrderBundle.hpp"
+#include "LazyOrder.hpp"
+#include "Scan.hpp"
+#include "MergedOrder.hpp"
+#include "PartitionedContainer.hpp"
+#include "SharedContainer.hpp"
+#include "StringArenaContainer.hpp"
+#include "SmallContainer.hpp"
+#include "Trace.hpp"
 
 #include <vector>
 #include <algorithm>
 #include <limits>
+#include <string>
+#include <random>
+#include <sstream>
+#include <fstream>
+#include <system_error>
+#include <atomic>
+#include <thread>
+#include <numeric>
+#include <ranges>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 using namespace container;
 
@@ -315,4 +337,2096 @@ TEST_CASE("Real world example") {
     
     // Remove failing grade (if any under 60)
     // grades.remove(59); // Would throw since no such grade exists
-}
\ No newline at end of file
+}
+//  KEY PROJECTIONS
+struct Trade {
+    std::string symbol;
+    double price;
+    int quantity;
+};
+
+TEST_SUITE("Key Projections") {
+
+    TEST_CASE("Sorted orders by projected key") {
+        MyContainer<Trade> trades;
+        trades.add({"AAPL", 190.5, 10});
+        trades.add({"MSFT", 410.0, 3});
+        trades.add({"IBM", 150.25, 7});
+        trades.add({"ORCL", 120.0, 12});
+
+        SUBCASE("Ascending by member pointer") {
+            std::vector<std::string> symbols;
+            for (const auto& trade : trades.ascending(&Trade::price)) {
+                symbols.push_back(trade.symbol);
+            }
+            CHECK(symbols == std::vector<std::string>{"ORCL", "IBM", "AAPL", "MSFT"});
+        }
+
+        SUBCASE("Descending by member pointer") {
+            std::vector<int> quantities;
+            for (const auto& trade : trades.descending(&Trade::quantity)) {
+                quantities.push_back(trade.quantity);
+            }
+            CHECK(quantities == std::vector<int>{12, 10, 7, 3});
+        }
+
+        SUBCASE("SideCross by lambda") {
+            std::vector<std::string> symbols;
+            for (const auto& trade : trades.sidecross([](const Trade& tr) { return tr.price * tr.quantity; })) {
+                symbols.push_back(trade.symbol);
+            }
+            // Notionals: AAPL 1905, MSFT 1230, IBM 1051.75, ORCL 1440
+            CHECK(symbols == std::vector<std::string>{"IBM", "AAPL", "MSFT", "ORCL"});
+        }
+
+        SUBCASE("Modification through projected order") {
+            for (auto& trade : trades.ascending(&Trade::price)) {
+                trade.quantity += 1;
+            }
+            CHECK(trades[1].quantity == 4);
+        }
+    }
+
+    TEST_CASE("Projection keeps equal keys in insertion order") {
+        MyContainer<int> container;
+        for (int v : {13, 21, 5, 33, 12}) {
+            container.add(v);
+        }
+        auto values = extractValues(container.ascending([](int v) { return v % 10; }));
+        CHECK(values == std::vector<int>{21, 12, 13, 33, 5});
+        CHECK_THROWS_AS(MyContainer<int>().ascending([](int v) { return v; }), std::runtime_error);
+    }
+}
+
+//  STATIC DISPATCH
+template<typename View>
+std::vector<int> extractStatic(const View& view) {
+    std::vector<int> result;
+    view.for_each([&](int v) { result.push_back(v); });
+    return result;
+}
+
+TEST_SUITE("Static Dispatch") {
+
+    TEST_CASE("Static views match virtual iterators") {
+        for (int n = 1; n <= 12; ++n) {
+            MyContainer<int> container;
+            for (int i = 0; i < n; ++i) {
+                container.add((i * 7 + 3) % 11);
+            }
+            CAPTURE(n);
+            CHECK(extractValues(container.view<order_tag::order>()) == extractValues(container.order()));
+            CHECK(extractValues(container.view<order_tag::reverse>()) == extractValues(container.reverse()));
+            CHECK(extractValues(container.view<order_tag::middleout>()) == extractValues(container.middleout()));
+            CHECK(extractValues(container.view<order_tag::ascending>()) == extractValues(container.ascending()));
+            CHECK(extractValues(container.view<order_tag::descending>()) == extractValues(container.descending()));
+            CHECK(extractValues(container.view<order_tag::sidecross>()) == extractValues(container.sidecross()));
+            CHECK(extractStatic(container.view<order_tag::sidecross>()) == extractValues(container.sidecross()));
+        }
+    }
+
+    TEST_CASE("Static views modify elements and reject empty containers") {
+        MyContainer<int> container;
+        CHECK_THROWS_AS(container.view<order_tag::ascending>(), ContainerEmptyException);
+
+        container.add(3);
+        container.add(1);
+        container.add(2);
+        for (auto& v : container.view<order_tag::ascending>()) {
+            v *= 10;
+        }
+        CHECK(extractValues(container.view<order_tag::order>()) == std::vector<int>{30, 10, 20});
+    }
+}
+
+//  MAINTAINED SORTED PERMUTATION
+TEST_SUITE("Tail Merge") {
+
+    TEST_CASE("Appends after a sorted read are merged in") {
+        MyContainer<int> container;
+        for (int v : {50, 10, 40, 20, 30}) {
+            container.add(v);
+        }
+        CHECK(extractValues(container.ascending()) == std::vector<int>{10, 20, 30, 40, 50});
+
+        for (int v : {35, 5, 55, 20}) {
+            container.add(v);
+        }
+        CHECK(extractValues(container.ascending()) == std::vector<int>{5, 10, 20, 20, 30, 35, 40, 50, 55});
+        CHECK(extractValues(container.descending()) == std::vector<int>{55, 50, 40, 35, 30, 20, 20, 10, 5});
+        CHECK(extractValues(container.sidecross()) == std::vector<int>{5, 55, 10, 50, 20, 40, 20, 35, 30});
+
+        // Equal values keep insertion order: the older 20 (index 3) comes first
+        const auto& perm = container.sortedIndices();
+        CHECK(perm[2] == 3);
+        CHECK(perm[3] == 8);
+    }
+
+    TEST_CASE("Removal compacts the permutation") {
+        MyContainer<int> container;
+        for (int v : {7, 3, 9, 3, 1}) {
+            container.add(v);
+        }
+        container.ascending();
+        container.remove(3);
+        CHECK(container.sortedIndices() == std::vector<size_t>{2, 0, 1});
+        container.add(4);
+        CHECK(extractValues(container.ascending()) == std::vector<int>{1, 4, 7, 9});
+    }
+
+    TEST_CASE("Values modified through an iterator force a re-sort") {
+        MyContainer<int> container;
+        for (int v : {7, 15, 6, 1, 2}) {
+            container.add(v);
+        }
+        for (auto& v : container.ascending()) {
+            if (v == 7) v = 12;
+            if (v == 1) v = 100;
+        }
+        container.add(0);
+        CHECK(extractValues(container.ascending()) == std::vector<int>{0, 2, 6, 12, 15, 100});
+
+        container.clear();
+        container.add(3);
+        CHECK(extractValues(container.ascending()) == std::vector<int>{3});
+    }
+
+    TEST_CASE("Several threads may create orders from an unmodified container") {
+        MyContainer<int> container;
+        for (int i = 0; i < 20000; ++i) container.add((i * 7919) % 20011);
+        std::vector<int> sorted = container.getT();
+        std::sort(sorted.begin(), sorted.end());
+
+        for (int round = 0; round < 2; ++round) {
+            // The second round starts with an unsorted tail to merge in
+            for (int i = 0; i < 1000 * round; ++i) {
+                container.add((i * 104729) % 20011);
+                sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), (i * 104729) % 20011), (i * 104729) % 20011);
+            }
+            std::atomic<int> mismatches{0};
+            std::vector<std::thread> threads;
+            for (int w = 0; w < 8; ++w) {
+                threads.emplace_back([&, w] {
+                    std::vector<int> values = w % 2 ? extractValues(container.descending())
+                                                    : extractValues(container.ascending());
+                    if (w % 2) std::reverse(values.begin(), values.end());
+                    if (values != sorted) ++mismatches;
+                    if (container.sidecross().size() != sorted.size()) ++mismatches;
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            CHECK(mismatches.load() == 0);
+        }
+    }
+}
+
+//  PRESORTEDNESS
+TEST_SUITE("Presorted Input") {
+
+    template<typename Data>
+    void checkAgainstStdSort(const Data& data) {
+        std::vector<size_t> indices(data.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        auto less = [&](size_t i, size_t j) { return data[i] < data[j]; };
+        if (!sort_engine::sortPresorted(indices.begin(), indices.end(), less)) {
+            return;
+        }
+        std::vector<size_t> expected(data.size());
+        std::iota(expected.begin(), expected.end(), 0);
+        std::stable_sort(expected.begin(), expected.end(), less);
+        CHECK(indices == expected);
+    }
+
+    TEST_CASE("Runs are detected and merged") {
+        std::vector<size_t> indices(6);
+        std::iota(indices.begin(), indices.end(), 0);
+
+        std::vector<int> ascending = {1, 2, 2, 3, 8, 9};
+        CHECK(sort_engine::sortPresorted(indices.begin(), indices.end(),
+              [&](size_t i, size_t j) { return ascending[i] < ascending[j]; }));
+        CHECK(indices == std::vector<size_t>{0, 1, 2, 3, 4, 5});
+
+        checkAgainstStdSort(std::vector<int>{9, 7, 5, 3, 1, 0});
+        checkAgainstStdSort(std::vector<int>{1, 4, 9, 2, 3, 3, 8, 7, 6, 0});
+        checkAgainstStdSort(std::vector<int>{5, 5, 5, 1, 1, 1});
+        checkAgainstStdSort(std::vector<std::string>{"b", "c", "a", "d"});
+    }
+
+    TEST_CASE("Non-increasing runs with duplicates stay one run and keep ties by index") {
+        std::vector<int> reversed;
+        for (int i = 500; i > 0; --i) {
+            reversed.push_back(i / 4);
+        }
+        std::vector<size_t> indices(reversed.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        auto less = [&](size_t i, size_t j) { return reversed[i] < reversed[j]; };
+        CHECK(sort_engine::sortPresorted(indices.begin(), indices.end(), less));
+        std::vector<size_t> expected(reversed.size());
+        std::iota(expected.begin(), expected.end(), 0);
+        std::stable_sort(expected.begin(), expected.end(), less);
+        CHECK(indices == expected);
+
+        checkAgainstStdSort(std::vector<int>{4, 4, 3, 3, 3, 1, 2, 2, 7, 7, 0});
+        checkAgainstStdSort(std::vector<int>{2, 2, 2, 1, 1, 5, 5, 4});
+
+        MyContainer<int> container;
+        for (int v : reversed) container.add(v);
+        auto& sorted = container.sortedIndices();
+        CHECK(std::vector<size_t>(sorted.begin(), sorted.end()) == expected);
+    }
+
+    TEST_CASE("Random input falls back to the general sort") {
+        std::vector<int> noisy;
+        for (int i = 0; i < 200; ++i) {
+            noisy.push_back((i * 7919) % 211);
+        }
+        std::vector<size_t> indices(noisy.size());
+        std::iota(indices.begin(), indices.end(), 0);
+        CHECK_FALSE(sort_engine::sortPresorted(indices.begin(), indices.end(),
+                    [&](size_t i, size_t j) { return noisy[i] < noisy[j]; }));
+
+        MyContainer<int> container;
+        for (int v : noisy) container.add(v);
+        auto values = extractValues(container.ascending());
+        CHECK(std::is_sorted(values.begin(), values.end()));
+    }
+
+    TEST_CASE("Sorted orders on presorted containers") {
+        MyContainer<int> container;
+        for (int i = 100; i > 0; --i) container.add(i);
+        auto values = extractValues(container.ascending());
+        CHECK(values.front() == 1);
+        CHECK(values.back() == 100);
+        CHECK(std::is_sorted(values.begin(), values.end()));
+        CHECK(extractValues(container.descending()) == extractValues(container.order()));
+    }
+}
+
+//  ORDER BUNDLE
+TEST_SUITE("Order Bundle") {
+
+    TEST_CASE("Bundle matches the individual orders") {
+        MyContainer<int> container;
+        for (int v : {5, 2, 8, 1, 9, 4}) {
+            container.add(v);
+        }
+        auto all = container.orders();
+        CHECK(extractValues(all.ascending()) == extractValues(container.ascending()));
+        CHECK(extractValues(all.descending()) == extractValues(container.descending()));
+        CHECK(extractValues(all.sidecross()) == extractValues(container.sidecross()));
+        CHECK(extractValues(all.order()) == extractValues(container.order()));
+        CHECK(extractValues(all.reverse()) == extractValues(container.reverse()));
+        CHECK(extractValues(all.middleout()) == extractValues(container.middleout()));
+    }
+
+    TEST_CASE("Bundle views write through to the container") {
+        MyContainer<int> container;
+        CHECK_THROWS_AS(container.orders(), ContainerEmptyException);
+        container.add(3);
+        container.add(1);
+        auto all = container.orders();
+        for (auto& v : all.descending()) {
+            v += 1;
+        }
+        CHECK(extractValues(container.order()) == std::vector<int>{4, 2});
+    }
+}
+
+//  COROUTINE GENERATORS
+TEST_SUITE("Lazy Generators") {
+
+    TEST_CASE("Generators produce the same sequences as the iterators") {
+        MyContainer<int> container;
+        for (int v : {5, 2, 8, 1, 9, 4, 7}) {
+            container.add(v);
+        }
+        CHECK(extractValues(lazy::order(container)) == extractValues(container.order()));
+        CHECK(extractValues(lazy::reverse(container)) == extractValues(container.reverse()));
+        CHECK(extractValues(lazy::ascending(container)) == extractValues(container.ascending()));
+        CHECK(extractValues(lazy::descending(container)) == extractValues(container.descending()));
+        CHECK(extractValues(lazy::sidecross(container)) == extractValues(container.sidecross()));
+        CHECK(extractValues(lazy::middleout(container)) == extractValues(container.middleout()));
+    }
+
+    TEST_CASE("Generators compose with std::ranges views") {
+        MyContainer<int> container;
+        for (int v = 1; v <= 10; ++v) {
+            container.add(v * 3 % 11);
+        }
+        std::vector<int> picked;
+        for (int v : lazy::descending(container)
+                         | std::views::filter([](int v) { return v % 2 == 0; })
+                         | std::views::take(3)) {
+            picked.push_back(v);
+        }
+        CHECK(picked == std::vector<int>{10, 8, 6});
+
+        static_assert(std::ranges::input_range<Generator<int>>);
+        static_assert(std::ranges::view<Generator<int>>);
+    }
+
+    TEST_CASE("Generators yield references and check emptiness eagerly") {
+        MyContainer<int> container;
+        CHECK_THROWS_AS(lazy::ascending(container), ContainerEmptyException);
+
+        container.add(2);
+        container.add(1);
+        for (int& v : lazy::ascending(container)) {
+            v *= 100;
+        }
+        CHECK(extractValues(container.order()) == std::vector<int>{200, 100});
+    }
+}
+
+//  PREFETCHING TRAVERSAL
+TEST_SUITE("Prefetching Traversal") {
+
+    TEST_CASE("for_each visits the same elements at every distance") {
+        MyContainer<int> container;
+        for (int i = 0; i < 100; ++i) {
+            container.add((i * 37) % 101);
+        }
+        auto expected = extractValues(container.sidecross());
+        for (size_t distance : {0, 1, 16, 99, 100, 500}) {
+            auto order = container.sidecross();
+            std::vector<int> visited;
+            order.for_each([&](int v) { visited.push_back(v); }, distance);
+            CAPTURE(distance);
+            CHECK(visited == expected);
+        }
+    }
+
+    TEST_CASE("for_each can modify elements") {
+        MyContainer<int> container;
+        container.add(2);
+        container.add(1);
+        container.ascending().for_each([](int& v) { v += 5; });
+        CHECK(extractValues(container.order()) == std::vector<int>{7, 6});
+    }
+}
+
+//  MATERIALIZATION
+TEST_SUITE("Materialize") {
+
+    TEST_CASE("to_vector matches the traversal for several element types") {
+        MyContainer<int> ints;
+        MyContainer<double> doubles;
+        MyContainer<short> shorts;
+        MyContainer<std::string> strings;
+        for (int i = 0; i < 37; ++i) {
+            int v = (i * 17) % 23;
+            ints.add(v);
+            doubles.add(v * 0.5);
+            shorts.add(static_cast<short>(v));
+            strings.add(std::to_string(v));
+        }
+        CHECK(ints.sidecross().to_vector() == extractValues(ints.sidecross()));
+        CHECK(ints.middleout().to_vector() == extractValues(ints.middleout()));
+
+        std::vector<double> expected_doubles;
+        for (double d : doubles.descending()) expected_doubles.push_back(d);
+        CHECK(doubles.descending().to_vector() == expected_doubles);
+
+        std::vector<short> expected_shorts;
+        for (short v : shorts.ascending()) expected_shorts.push_back(v);
+        CHECK(shorts.ascending().to_vector() == expected_shorts);
+
+        std::vector<std::string> expected_strings;
+        for (const auto& v : strings.reverse()) expected_strings.push_back(v);
+        CHECK(strings.reverse().to_vector() == expected_strings);
+    }
+
+    TEST_CASE("materialize writes into a caller buffer") {
+        MyContainer<long long> container;
+        for (long long v : {40LL, 10LL, 30LL, 20LL, 50LL}) {
+            container.add(v);
+        }
+        std::vector<long long> buffer(6, -1);
+        container.ascending().materialize(buffer);
+        CHECK(buffer == std::vector<long long>{10, 20, 30, 40, 50, -1});
+
+        std::vector<long long> small(4);
+        CHECK_THROWS_AS(container.ascending().materialize(small), IteratorException);
+    }
+
+    TEST_CASE("Large gathers are split into chunks") {
+        MyContainer<int> container;
+        const int SIZE = 1 << 20;
+        for (int i = 0; i < SIZE; ++i) {
+            container.add(SIZE - i);
+        }
+        auto values = container.ascending().to_vector();
+        CHECK(values.size() == static_cast<size_t>(SIZE));
+        CHECK(values.front() == 1);
+        CHECK(values.back() == SIZE);
+        CHECK(std::is_sorted(values.begin(), values.end()));
+
+        std::vector<size_t> seen(parallel::chunkCount(SIZE, simd::GATHER_PARALLEL_CHUNK), 0);
+        parallel::forChunks(SIZE, simd::GATHER_PARALLEL_CHUNK, [&](size_t chunk, size_t begin, size_t end) {
+            seen[chunk] = end - begin;
+        });
+        CHECK(std::accumulate(seen.begin(), seen.end(), size_t(0)) == static_cast<size_t>(SIZE));
+    }
+
+    TEST_CASE("A thread that cannot be started is reported after the running ones finish") {
+        pid_t child = fork();
+        REQUIRE(child >= 0);
+        if (child == 0) {
+            // Leave room for one new thread stack; past it and the few stacks glibc
+            // caches from earlier threads, starting a thread fails
+            std::ifstream statm("/proc/self/statm");
+            size_t pages = 0;
+            statm >> pages;
+            rlimit limit{};
+            limit.rlim_cur = limit.rlim_max = pages * sysconf(_SC_PAGESIZE) + (size_t(12) << 20);
+            setrlimit(RLIMIT_AS, &limit);
+            std::atomic<int> finished{0};
+            int status = 1;
+            try {
+                parallel::forEachChunk(64, 64, [&](size_t chunk, size_t, size_t) {
+                    if (chunk > 0) std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    ++finished;
+                });
+                status = 2;
+            } catch (const std::system_error&) {
+                status = finished.load() > 0 ? 0 : 3;
+            }
+            _exit(status);
+        }
+        int status = -1;
+        waitpid(child, &status, 0);
+        CHECK(WIFEXITED(status));
+        CHECK(WEXITSTATUS(status) == 0);
+    }
+}
+
+//  PHYSICAL REORDERING
+TEST_SUITE("Physical Reorder") {
+
+    TEST_CASE("Storage follows the applied order") {
+        MyContainer<int> container;
+        for (int v : {5, 2, 8, 1, 9, 4}) {
+            container.add(v);
+        }
+
+        SUBCASE("Ascending makes order() sorted") {
+            auto previous = container.physically_reorder(container.ascending());
+            CHECK(previous.empty());
+            CHECK(extractValues(container.order()) == std::vector<int>{1, 2, 4, 5, 8, 9});
+            CHECK(extractValues(container.descending()) == std::vector<int>{9, 8, 5, 4, 2, 1});
+        }
+
+        SUBCASE("Insertion positions on request") {
+            auto previous = container.physically_reorder(container.sidecross(), true);
+            CHECK(extractValues(container.order()) == std::vector<int>{1, 9, 2, 8, 4, 5});
+            CHECK(previous == std::vector<size_t>{3, 4, 1, 2, 5, 0});
+        }
+    }
+
+    TEST_CASE("Reorder works for non-trivial types and rejects foreign orders") {
+        MyContainer<std::string> words;
+        for (const char* w : {"pear", "apple", "fig", "banana"}) {
+            words.add(w);
+        }
+        words.physically_reorder(words.middleout());
+        CHECK(words.getT() == std::vector<std::string>{"fig", "apple", "banana", "pear"});
+
+        MyContainer<std::string> other;
+        other.add("x");
+        CHECK_THROWS_AS(words.physically_reorder(other.order()), OrderMismatchException);
+
+        auto stale = words.order();
+        words.add("kiwi");
+        CHECK_THROWS_AS(words.physically_reorder(stale), std::invalid_argument);
+    }
+}
+
+//  REDUCTIONS
+TEST_SUITE("Reductions") {
+
+    TEST_CASE("Integer aggregates") {
+        MyContainer<int> container;
+        CHECK(container.sum() == 0);
+        CHECK_THROWS_AS(container.min(), ContainerEmptyException);
+        CHECK_THROWS_AS(container.mean(), ContainerEmptyException);
+
+        for (int v = 1; v <= 21; ++v) {
+            container.add(v % 2 ? v : -v);
+        }
+        CHECK(container.sum() == 11);
+        CHECK(container.min() == -20);
+        CHECK(container.max() == 21);
+        CHECK(container.minmax() == std::pair<int, int>{-20, 21});
+        CHECK(container.mean() == doctest::Approx(11.0 / 21.0));
+
+        MyContainer<int> big;
+        big.add(std::numeric_limits<int>::max());
+        big.add(std::numeric_limits<int>::max());
+        CHECK(big.sum() == 2LL * std::numeric_limits<int>::max());
+    }
+
+    TEST_CASE("Floating-point aggregates are compensated") {
+        MyContainer<float> container;
+        container.add(1.0f);
+        for (int i = 0; i < 100000; ++i) {
+            container.add(1e-8f);
+        }
+        CHECK(container.sum() == doctest::Approx(1.001f).epsilon(1e-6));
+
+        MyContainer<double> values;
+        for (double v : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0, 1e9}) {
+            values.add(v);
+        }
+        values.remove(1e9);
+        CHECK(values.mean() == doctest::Approx(5.0));
+        CHECK(values.variance() == doctest::Approx(4.0));
+        CHECK(values.minmax() == std::pair<double, double>{2.0, 9.0});
+    }
+
+    TEST_CASE("Large and non-arithmetic containers") {
+        MyContainer<long long> large;
+        const long long SIZE = 300000;
+        for (long long i = 0; i < SIZE; ++i) {
+            large.add(i);
+        }
+        CHECK(large.sum() == SIZE * (SIZE - 1) / 2);
+        CHECK(large.max() == SIZE - 1);
+        CHECK(large.variance() == doctest::Approx((SIZE * SIZE - 1) / 12.0));
+
+        MyContainer<std::string> words;
+        words.add("b");
+        words.add("a");
+        words.add("c");
+        CHECK(words.sum() == "bac");
+        CHECK(words.min() == "a");
+        CHECK(words.max() == "c");
+    }
+}
+
+//  PREFIX SCANS
+TEST_SUITE("Prefix Scans") {
+
+    TEST_CASE("Inclusive and exclusive scans follow the order") {
+        MyContainer<int> container;
+        for (int v : {4, 1, 3, 2}) {
+            container.add(v);
+        }
+        std::vector<long long> out(4);
+
+        inclusive_scan(container.ascending(), out);
+        CHECK(out == std::vector<long long>{1, 3, 6, 10});
+
+        exclusive_scan(container.order(), out, 100LL);
+        CHECK(out == std::vector<long long>{100, 104, 105, 108});
+
+        std::vector<int> running_max(4);
+        inclusive_scan(container.reverse(), running_max, [](int a, int b) { return std::max(a, b); });
+        CHECK(running_max == std::vector<int>{2, 3, 3, 4});
+
+        std::vector<long long> tiny(3);
+        CHECK_THROWS_AS(inclusive_scan(container.order(), tiny), IteratorException);
+    }
+
+    TEST_CASE("Chunked scans match the sequential scan") {
+        std::vector<int> data;
+        for (int i = 0; i < 1003; ++i) {
+            data.push_back((i * 31) % 17 - 8);
+        }
+        std::vector<size_t> idx(data.size());
+        std::iota(idx.begin(), idx.end(), 0);
+        std::reverse(idx.begin(), idx.end());
+
+        std::vector<long long> expected_inc(data.size()), expected_exc(data.size());
+        scan::scanChunks(data.data(), idx.data(), idx.size(), expected_inc.data(), 0LL, std::plus<>(), true, 1);
+        scan::scanChunks(data.data(), idx.data(), idx.size(), expected_exc.data(), 5LL, std::plus<>(), false, 1);
+        CHECK(expected_inc.back() == std::accumulate(data.begin(), data.end(), 0LL));
+        CHECK(expected_exc.front() == 5);
+
+        for (size_t chunks : {2, 3, 7, 64, 2000}) {
+            std::vector<long long> inc(data.size()), exc(data.size());
+            scan::scanChunks(data.data(), idx.data(), idx.size(), inc.data(), 0LL, std::plus<>(), true, chunks);
+            scan::scanChunks(data.data(), idx.data(), idx.size(), exc.data(), 5LL, std::plus<>(), false, chunks);
+            CAPTURE(chunks);
+            CHECK(inc == expected_inc);
+            CHECK(exc == expected_exc);
+        }
+
+        // Non-commutative operator: string concatenation keeps the order
+        std::vector<std::string> words = {"a", "b", "c", "d", "e"};
+        std::vector<size_t> forward = {0, 1, 2, 3, 4};
+        std::vector<std::string> joined(5);
+        scan::scanChunks(words.data(), forward.data(), 5, joined.data(), std::string(), std::plus<>(), true, 3);
+        CHECK(joined == std::vector<std::string>{"a", "ab", "abc", "abcd", "abcde"});
+    }
+}
+
+//  K-WAY MERGE
+TEST_SUITE("Merged Orders") {
+
+    TEST_CASE("Merging matches sorting the concatenation") {
+        for (size_t parts : {1, 2, 3, 5, 8, 9}) {
+            std::vector<MyContainer<int>> containers(parts);
+            std::vector<int> all;
+            for (size_t p = 0; p < parts; ++p) {
+                for (size_t i = 0; i < p * 3 % 7 + (p == 0); ++i) {
+                    int v = static_cast<int>((p * 13 + i * 29) % 23);
+                    containers[p].add(v);
+                    all.push_back(v);
+                }
+            }
+            std::vector<MyContainer<int>*> inputs;
+            for (auto& c : containers) inputs.push_back(&c);
+
+            std::sort(all.begin(), all.end());
+            CAPTURE(parts);
+            CHECK(extractValues(mergedAscending(inputs)) == all);
+            std::reverse(all.begin(), all.end());
+            CHECK(extractValues(mergedDescending(inputs)) == all);
+        }
+    }
+
+    TEST_CASE("Extreme values, ties and non-arithmetic elements merge in order") {
+        constexpr int hi = std::numeric_limits<int>::max();
+        constexpr int lo = std::numeric_limits<int>::lowest();
+        MyContainer<int> a, b, c;
+        for (int v : {hi, 0, lo}) a.add(v);
+        for (int v : {hi, hi}) b.add(v);
+        c.add(lo);
+        std::vector<MyContainer<int>*> inputs = {&a, &b, &c};
+        CHECK(extractValues(mergedAscending(inputs)) == std::vector<int>{lo, lo, 0, hi, hi, hi});
+        CHECK(extractValues(mergedDescending(inputs)) == std::vector<int>{hi, hi, hi, 0, lo, lo});
+
+        // Ties come out in container order
+        std::vector<const int*> sources;
+        for (int& v : mergedAscending(inputs)) sources.push_back(&v);
+        CHECK(sources[0] == &a[2]);
+        CHECK(sources[3] == &a[0]);
+        CHECK(sources[4] == &b[0]);
+
+        MyContainer<std::string> x, y;
+        for (const char* w : {"pear", "fig"}) x.add(w);
+        for (const char* w : {"apple", "fig", "quince"}) y.add(w);
+        std::vector<std::string> words;
+        for (const std::string& w : mergedDescending<std::string>({&x, &y})) words.push_back(w);
+        CHECK(words == std::vector<std::string>{"quince", "pear", "fig", "fig", "apple"});
+    }
+
+    TEST_CASE("Infinite heads and ties at the numeric limits merge in order") {
+        constexpr double inf = std::numeric_limits<double>::infinity();
+        constexpr double hi = std::numeric_limits<double>::max();
+        constexpr double lo = std::numeric_limits<double>::lowest();
+        auto collect = [](auto merged) {
+            std::vector<double> values;
+            for (double v : merged) values.push_back(v);
+            return values;
+        };
+        MyContainer<double> a, b, c;
+        a.add(inf);
+        b.add(1.0);
+        CHECK(collect(mergedAscending<double>({&a, &b})) == std::vector<double>{1.0, inf});
+        a[0] = -inf;
+        CHECK(collect(mergedDescending<double>({&a, &b})) == std::vector<double>{1.0, -inf});
+
+        for (double v : {inf, hi, lo, -inf}) a.add(v);
+        for (double v : {hi, lo}) b.add(v);
+        c.add(inf);
+        c.add(-inf);
+        std::vector<MyContainer<double>*> inputs = {&a, &b, &c};
+        std::vector<double> all = {-inf, -inf, -inf, lo, lo, 1.0, hi, hi, inf, inf};
+        CHECK(collect(mergedAscending(inputs)) == all);
+        std::reverse(all.begin(), all.end());
+        CHECK(collect(mergedDescending(inputs)) == all);
+
+        MyContainer<int> x, y;
+        x.add(std::numeric_limits<int>::max());
+        y.add(std::numeric_limits<int>::max());
+        y.add(std::numeric_limits<int>::lowest());
+        std::vector<const int*> order;
+        for (int& v : mergedAscending<int>({&x, &y})) order.push_back(&v);
+        CHECK(order == std::vector<const int*>{&y[1], &x[0], &y[0]});
+    }
+
+    TEST_CASE("Merged views write through and reject all-empty input") {
+        MyContainer<int> a, b, empty;
+        a.add(5);
+        a.add(1);
+        b.add(3);
+        auto merged = mergedAscending<int>({&a, &empty, &b});
+        CHECK(merged.size() == 3);
+        int rank = 0;
+        for (int& v : merged) {
+            v = ++rank;
+        }
+        CHECK(extractValues(a.order()) == std::vector<int>{3, 1});
+        CHECK(extractValues(b.order()) == std::vector<int>{2});
+
+        CHECK_THROWS_AS(mergedAscending<int>({&empty}), ContainerEmptyException);
+    }
+}
+
+//  PARTITIONED CONTAINER
+TEST_SUITE("Partitioned Container") {
+
+    // Reference container holding the partitions back to back
+    MyContainer<int> concatenated(PartitionedContainer<int>& pc) {
+        MyContainer<int> flat;
+        for (size_t p = 0; p < pc.partitionCount(); ++p) {
+            for (int v : pc.partition(p).getT()) flat.add(v);
+        }
+        return flat;
+    }
+
+    void checkSixOrders(PartitionedContainer<int>& pc) {
+        MyContainer<int> flat = concatenated(pc);
+        CHECK(extractValues(pc.order()) == extractValues(flat.order()));
+        CHECK(extractValues(pc.reverse()) == extractValues(flat.reverse()));
+        CHECK(extractValues(pc.middleout()) == extractValues(flat.middleout()));
+        CHECK(extractValues(pc.ascending()) == extractValues(flat.ascending()));
+        CHECK(extractValues(pc.descending()) == extractValues(flat.descending()));
+        CHECK(extractValues(pc.sidecross()) == extractValues(flat.sidecross()));
+    }
+
+    TEST_CASE("Hash partitioning serves all six orders") {
+        for (size_t partitions : {1, 3, 8}) {
+            PartitionedContainer<int> pc(partitions);
+            CHECK(pc.partitionScheme() == PartitionScheme::Hash);
+            for (int i = 0; i < 50; ++i) {
+                pc.add(i * 37 % 23);
+            }
+            CHECK(pc.size() == 50);
+            CAPTURE(partitions);
+            checkSixOrders(pc);
+        }
+    }
+
+    TEST_CASE("Range partitioning keeps one key range per partition") {
+        PartitionedContainer<int> pc(std::vector<int>{10, 20, 30});
+        CHECK(pc.partitionScheme() == PartitionScheme::Range);
+        CHECK(pc.partitionCount() == 4);
+        for (int v : {25, 3, 14, 31, 9, 20, 10, 2, 45}) {
+            pc.add(v);
+        }
+        CHECK(pc.partition(0).getT() == std::vector<int>{3, 9, 2});
+        CHECK(pc.partition(1).getT() == std::vector<int>{14, 10});
+        CHECK(pc.partition(2).getT() == std::vector<int>{25, 20});
+        CHECK(pc.partition(3).getT() == std::vector<int>{31, 45});
+        checkSixOrders(pc);
+
+        // Middle-out has to step over empty partitions
+        PartitionedContainer<int> sparse(std::vector<int>{0, 10, 20, 30, 40});
+        for (int v : {5, 35, 36, 1}) {
+            sparse.add(v);
+        }
+        checkSixOrders(sparse);
+    }
+
+    TEST_CASE("Removal, modification and errors") {
+        PartitionedContainer<int> pc(4);
+        CHECK(pc.empty());
+        CHECK_THROWS_AS(pc.ascending(), ContainerEmptyException);
+        CHECK_THROWS_AS(pc.remove(1), ContainerEmptyException);
+        for (int v : {4, 7, 4, 1, 9}) {
+            pc.add(v);
+        }
+        pc.remove(4);
+        CHECK(extractValues(pc.ascending()) == std::vector<int>{1, 7, 9});
+        CHECK_THROWS_AS(pc.remove(4), ElementNotFoundException);
+
+        for (int& v : pc.descending()) {
+            v *= 10;
+        }
+        CHECK(extractValues(pc.ascending()) == std::vector<int>{10, 70, 90});
+        CHECK_THROWS_AS(pc.partition(4), IndexOutOfBoundsException);
+
+        CHECK_THROWS_AS(PartitionedContainer<int>(size_t(0)), std::invalid_argument);
+        CHECK_THROWS_AS(PartitionedContainer<int>(std::vector<int>{5, 5}), std::invalid_argument);
+        CHECK(PartitionedContainer<int>::partitionsFor(0) == 1);
+        CHECK(PartitionedContainer<int>::partitionsFor(1 << 20) == 16);
+    }
+
+    // Ordered but not hashable; counts comparisons across the sort threads
+    struct Version {
+        int number;
+        static inline std::atomic<size_t> comparisons{0};
+        bool operator<(const Version& other) const { ++comparisons; return number < other.number; }
+        bool operator==(const Version& other) const { return number == other.number; }
+    };
+
+    TEST_CASE("Range partitioning needs no std::hash and sorts once per traversal") {
+        static_assert(!is_hashable_v<Version>);
+        PartitionedContainer<Version> pc(std::vector<Version>{{10}, {20}});
+        for (int v : {25, 3, 14, 9, 20, 2}) {
+            pc.add(Version{v});
+        }
+        pc.remove(Version{9});
+        auto numbers = [](Generator<Version> walk) {
+            std::vector<int> out;
+            for (const Version& v : walk) out.push_back(v.number);
+            return out;
+        };
+        CHECK(numbers(pc.ascending()) == std::vector<int>{2, 3, 14, 20, 25});
+
+        // With current permutations, a traversal only pays one validation pass
+        Version::comparisons = 0;
+        CHECK(numbers(pc.ascending()) == std::vector<int>{2, 3, 14, 20, 25});
+        size_t one_pass = Version::comparisons.exchange(0);
+        CHECK(numbers(pc.sidecross()) == std::vector<int>{2, 25, 3, 20, 14});
+        CHECK(Version::comparisons.load() == one_pass);
+    }
+}
+
+//  SHARED MEMORY
+TEST_SUITE("Shared Memory Container") {
+
+    std::string segmentName(const char* suffix) {
+        return "/mycontainer_test_" + std::to_string(getpid()) + "_" + suffix;
+    }
+
+    TEST_CASE("Readers see the loader's elements and permutation") {
+        std::string name = segmentName("orders");
+        SharedContainer<int>::unlink(name);
+        auto loader = SharedContainer<int>::create(name, 10);
+        MyContainer<int> reference;
+        for (int v : {7, 3, 9, 1, 5, 3}) {
+            loader.add(v);
+            reference.add(v);
+        }
+        CHECK_FALSE(loader.isPublished());
+        CHECK_THROWS_AS(SharedContainer<int>::open(name), SharedMemoryException);
+        CHECK_THROWS_AS(loader.ascending(), SharedMemoryException);
+        loader.publish();
+
+        auto reader = SharedContainer<int>::open(name);
+        CHECK(reader.size() == 6);
+        CHECK(reader.capacity() == 10);
+        CHECK(reader.values().data() != loader.values().data());
+        CHECK(extractValues(reader.order()) == extractValues(reference.order()));
+        CHECK(extractValues(reader.reverse()) == extractValues(reference.reverse()));
+        CHECK(extractValues(reader.middleout()) == extractValues(reference.middleout()));
+        CHECK(extractValues(reader.ascending()) == extractValues(reference.ascending()));
+        CHECK(extractValues(reader.descending()) == extractValues(reference.descending()));
+        CHECK(extractValues(reader.sidecross()) == extractValues(reference.sidecross()));
+
+        CHECK_THROWS_AS(loader.add(4), SharedMemoryException);
+        CHECK_THROWS_AS(reader.publish(), SharedMemoryException);
+        CHECK_THROWS_AS(SharedContainer<double>::open(name), SharedMemoryException);
+        CHECK(SharedContainer<int>::unlink(name));
+        CHECK_THROWS_AS(SharedContainer<int>::open(name), SharedMemoryException);
+    }
+
+    TEST_CASE("Another process iterates the published segment") {
+        std::string name = segmentName("fork");
+        SharedContainer<double>::unlink(name);
+        auto loader = SharedContainer<double>::create(name, 1000);
+        for (int i = 0; i < 1000; ++i) {
+            loader.add(static_cast<double>(i * 389 % 1000));
+        }
+        loader.publish();
+
+        pid_t child = fork();
+        REQUIRE(child >= 0);
+        if (child == 0) {
+            int status = 1;
+            try {
+                auto reader = SharedContainer<double>::open(name);
+                double expected = 0;
+                status = 0;
+                for (double v : reader.ascending()) {
+                    if (v != expected++) status = 2;
+                }
+            } catch (...) {
+                status = 3;
+            }
+            _exit(status);
+        }
+        int status = -1;
+        waitpid(child, &status, 0);
+        CHECK(WIFEXITED(status));
+        CHECK(WEXITSTATUS(status) == 0);
+        SharedContainer<double>::unlink(name);
+    }
+
+    TEST_CASE("Loader limits") {
+        std::string name = segmentName("limits");
+        SharedContainer<int>::unlink(name);
+        auto loader = SharedContainer<int>::create(name, 1);
+        CHECK_THROWS_AS(SharedContainer<int>::create(name, 1), SharedMemoryException);
+        loader.add(1);
+        CHECK_THROWS_AS(loader.add(2), SharedMemoryException);
+        loader.publish();
+        CHECK_THROWS_AS(loader.publish(), SharedMemoryException);
+        SharedContainer<int>::unlink(name);
+
+        std::string empty_name = segmentName("empty");
+        SharedContainer<int>::unlink(empty_name);
+        auto empty = SharedContainer<int>::create(empty_name, 0);
+        empty.publish();
+        CHECK_THROWS_AS(empty.order(), ContainerEmptyException);
+        SharedContainer<int>::unlink(empty_name);
+    }
+}
+
+//  TRACING
+TEST_SUITE("Tracing") {
+
+    TEST_CASE("Spans are recorded only when tracing is compiled in") {
+        trace::reset();
+        MyContainer<int> container;
+        for (int v : {3, 1, 2}) {
+            container.add(v);
+        }
+        auto asc = container.ascending();
+        std::vector<int> out(3);
+        asc.materialize(out);
+        container.remove(2);
+
+        std::ostringstream json;
+        trace::exportChromeTrace(json);
+        std::string text = json.str();
+        CHECK(text.rfind("{\"traceEvents\":[", 0) == 0);
+        CHECK(text.find("\"displayTimeUnit\"") != std::string::npos);
+
+        if constexpr (trace::enabled) {
+            // 3 adds, ascending + sortedIndices, materialize, remove
+            CHECK(trace::eventCount() == 7);
+            std::vector<int> walked;
+            for (int v : container.ascending()) walked.push_back(v);
+            CHECK(text.find("\"name\":\"traverse\"") == std::string::npos);
+            json.str("");
+            trace::exportChromeTrace(json);
+            text = json.str();
+            // ascending + sortedIndices, traverse
+            CHECK(trace::eventCount() == 10);
+            CHECK(text.find("\"name\":\"traverse\",\"cat\":\"container\",\"ph\":\"X\"") != std::string::npos);
+            CHECK(text.find("\"args\":{\"n\":2}") != std::string::npos);
+            CHECK(text.find("\"name\":\"add\"") != std::string::npos);
+            CHECK(text.find("\"name\":\"sortedIndices\",\"cat\":\"container\",\"ph\":\"X\"") != std::string::npos);
+            CHECK(text.find("\"args\":{\"n\":3}") != std::string::npos);
+            trace::reset();
+            CHECK(trace::eventCount() == 0);
+        } else {
+            CHECK(trace::eventCount() == 0);
+            CHECK(text.find("\"name\"") == std::string::npos);
+        }
+    }
+
+    TEST_CASE("Every thread records into its own buffer") {
+        if constexpr (trace::enabled) {
+            trace::reset();
+            std::vector<std::thread> threads;
+            for (int w = 0; w < 4; ++w) {
+                threads.emplace_back([] {
+                    MyContainer<int> local;
+                    for (int v = 0; v < 100; ++v) local.add(v);
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            CHECK(trace::eventCount() == 400);
+            CHECK(trace::droppedCount() == 0);
+            trace::reset();
+        }
+    }
+
+    TEST_CASE("Buffers of exited threads are reused and keep their spans") {
+        if constexpr (trace::enabled) {
+            trace::reset();
+            auto round = [] {
+                std::vector<std::thread> threads;
+                for (int w = 0; w < 4; ++w) {
+                    threads.emplace_back([] {
+                        MyContainer<int> local;
+                        for (int v = 0; v < 10; ++v) local.add(v);
+                    });
+                }
+                for (auto& thread : threads) thread.join();
+            };
+            round();
+            size_t buffers = trace::bufferCount();
+            for (int r = 0; r < 20; ++r) round();
+            CHECK(trace::bufferCount() == buffers);
+            CHECK(trace::eventCount() == 21 * 40);
+            trace::reset();
+        }
+    }
+}
+
+//  NON-NUMERIC ELEMENTS
+TEST_SUITE("String Elements") {
+
+    TEST_CASE("remove works for strings and names the missing value") {
+        MyContainer<std::string> container;
+        container.add("pear");
+        container.add("apple");
+        container.add("pear");
+        container.remove("pear");
+        CHECK(container.getT() == std::vector<std::string>{"apple"});
+        CHECK_THROWS_WITH_AS(container.remove("kiwi"), "Element not found: Value: kiwi", ElementNotFoundException);
+    }
+}
+
+//  STATS
+TEST_SUITE("Container Stats") {
+
+    TEST_CASE("Stats are off by default and count once enabled") {
+        MyContainer<int> container;
+        for (int v : {4, 2, 9, 1}) {
+            container.add(v);
+        }
+        container.ascending();
+        CHECK_FALSE(container.statsEnabled());
+        CHECK(container.stats().sorts == 0);
+
+        container.enableStats();
+        container.add(3);
+        container.ascending();     // tail sort of the new element
+        container.descending();    // permutation is current, no sort
+        container.order();
+        StatsSnapshot s = container.stats();
+        CHECK(s.sorts == 1);
+        CHECK(s.iterator_constructions == 3);
+        // The permutation grows once and the first order outgrows the pooled buffer;
+        // the next two orders borrow that buffer back
+        CHECK(s.index_allocations == 2);
+        CHECK(s.index_bytes >= 2 * 5 * sizeof(size_t));
+        CHECK(s.prepare_ns_max <= s.prepare_ns_total);
+
+        container.ascending([](int v) { return -v; });
+        CHECK(container.stats().sorts == 2);
+        container.remove(9);
+        container.sidecross();
+        CHECK(container.stats().sorts == 2);  // removal compacts the permutation instead of re-sorting
+
+        size_t fields = 0;
+        container.stats().visit([&](const char* name, uint64_t) {
+            CHECK(name != nullptr);
+            ++fields;
+        });
+        CHECK(fields == 6);
+
+        container.resetStats();
+        CHECK(container.stats().iterator_constructions == 0);
+        CHECK(container.stats().prepare_ns_total == 0);
+
+        MyContainer<int> copy = container;
+        CHECK(copy.statsEnabled());
+        copy.order();
+        CHECK(copy.stats().iterator_constructions == 1);
+        CHECK(container.stats().iterator_constructions == 0);
+
+        container.disableStats();
+        container.order();
+        CHECK(container.stats().iterator_constructions == 0);
+    }
+
+    TEST_CASE("Bundles and projected side-cross orders count their index buffers") {
+        MyContainer<int> container;
+        for (int v : {6, 3, 8, 1, 7, 2, 5, 4}) {
+            container.add(v);
+        }
+        container.enableStats();
+        container.orders();  // sorts once; bundles never borrow from the pool
+        container.resetStats();
+
+        container.orders();
+        StatsSnapshot s = container.stats();
+        CHECK(s.index_allocations == 1);
+        CHECK(s.index_bytes == 8 * sizeof(size_t));
+
+        // The pool is still empty: the order's buffer and the scratch permutation are both new
+        container.resetStats();
+        container.sidecross([](int v) { return -v; });
+        s = container.stats();
+        CHECK(s.index_allocations == 2);
+        CHECK(s.index_bytes == 2 * 8 * sizeof(size_t));
+
+        // Both buffers went back to the pool
+        container.resetStats();
+        container.sidecross([](int v) { return -v; });
+        CHECK(container.stats().index_allocations == 0);
+    }
+}
+
+//  SMALL-SIZE SORTING
+TEST_SUITE("Small Sorts") {
+
+    template <size_t N>
+    void checkNetworkSortsAllBinaryInputs() {
+        for (unsigned mask = 0; mask < (1u << N); ++mask) {
+            int keys[N];
+            size_t idx[N];
+            for (size_t i = 0; i < N; ++i) {
+                keys[i] = (mask >> i) & 1;
+                idx[i] = i;
+            }
+            sort_engine::sortNetwork<N>(keys, idx, std::less<>());
+            for (size_t i = 1; i < N; ++i) {
+                REQUIRE(keys[i - 1] <= keys[i]);
+            }
+        }
+    }
+
+    TEST_CASE("Networks sort every 0/1 input (and so every input)") {
+        static_assert(sort_engine::sorting_network<32>::count() == 191);
+        static_assert(sort_engine::sorting_network<8>::count() == 19);
+        checkNetworkSortsAllBinaryInputs<2>();
+        checkNetworkSortsAllBinaryInputs<5>();
+        checkNetworkSortsAllBinaryInputs<8>();
+        checkNetworkSortsAllBinaryInputs<13>();
+        checkNetworkSortsAllBinaryInputs<16>();
+    }
+
+    TEST_CASE("Small path matches a stable sort for every size up to 32") {
+        std::mt19937 rng(21);
+        for (size_t n = 0; n <= sort_engine::SMALL_SORT_MAX; ++n) {
+            for (int round = 0; round < 20; ++round) {
+                std::vector<double> keys(n);
+                for (double& k : keys) k = static_cast<double>(rng() % 7);
+                std::vector<size_t> expected(n), actual(n);
+                std::iota(expected.begin(), expected.end(), 0);
+                std::iota(actual.begin(), actual.end(), 0);
+                std::stable_sort(expected.begin(), expected.end(), [&](size_t a, size_t b) { return keys[a] < keys[b]; });
+                sort_engine::sortByKeys(keys, actual.begin(), actual.end());
+                CAPTURE(n);
+                REQUIRE(actual == expected);
+
+                std::stable_sort(expected.begin(), expected.end(), [&](size_t a, size_t b) { return keys[a] > keys[b]; });
+                std::iota(actual.begin(), actual.end(), 0);
+                sort_engine::sortByKeys(keys, actual.begin(), actual.end(), std::greater<>());
+                REQUIRE(actual == expected);
+            }
+        }
+    }
+
+    TEST_CASE("Packed 32-bit keys keep sign, float order and index tie-breaks") {
+        std::mt19937 rng(22);
+        for (size_t n = 2; n <= sort_engine::SMALL_SORT_MAX; ++n) {
+            std::vector<int> ints(n);
+            std::vector<float> floats(n);
+            for (size_t i = 0; i < n; ++i) {
+                ints[i] = static_cast<int>(rng() % 9) - 4;
+                floats[i] = static_cast<float>(ints[i]) * 0.5f;
+            }
+            floats[0] = -0.0f;
+            for (bool shuffled : {false, true}) {
+                std::vector<size_t> start(n);
+                std::iota(start.begin(), start.end(), 0);
+                if (shuffled) std::reverse(start.begin(), start.end());  // falls back to the pair network
+
+                auto check = [&](const auto& keys, auto comp) {
+                    std::vector<size_t> expected = start, actual = start;
+                    std::sort(expected.begin(), expected.end(), [&](size_t a, size_t b) {
+                        if (comp(keys[a], keys[b])) return true;
+                        if (comp(keys[b], keys[a])) return false;
+                        return a < b;
+                    });
+                    sort_engine::sortByKeys(keys, actual.begin(), actual.end(), comp);
+                    CAPTURE(n);
+                    CAPTURE(shuffled);
+                    REQUIRE(actual == expected);
+                };
+                check(ints, std::less<>());
+                check(ints, std::greater<>());
+                check(floats, std::less<>());
+                check(floats, std::greater<>());
+            }
+        }
+    }
+
+    TEST_CASE("Tiny containers of any type iterate in sorted order") {
+        MyContainer<int> numbers;
+        MyContainer<std::string> words;
+        for (int v : {9, -3, 7, 7, 0, 12, -8}) {
+            numbers.add(v);
+            words.add(std::to_string(v));
+        }
+        CHECK(extractValues(numbers.ascending()) == std::vector<int>{-8, -3, 0, 7, 7, 9, 12});
+        CHECK(extractValues(numbers.sidecross()) == std::vector<int>{-8, 12, -3, 9, 0, 7, 7});
+        std::vector<std::string> sorted_words;
+        for (const auto& w : words.ascending()) sorted_words.push_back(w);
+        CHECK(sorted_words == std::vector<std::string>{"-3", "-8", "0", "12", "7", "7", "9"});
+    }
+}
+
+//  VECTORIZED QUICKSORT
+TEST_SUITE("Vectorized Sort") {
+
+    std::vector<vqsort::Isa> availableIsas() {
+        std::vector<vqsort::Isa> isas{vqsort::Isa::Scalar};
+        if (cpu::hasAvx2()) isas.push_back(vqsort::Isa::Avx2);
+        if (cpu::hasAvx512()) isas.push_back(vqsort::Isa::Avx512);
+        return isas;
+    }
+
+    std::vector<uint64_t> makeWords(size_t n, int pattern, std::mt19937_64& rng) {
+        std::vector<uint64_t> words(n);
+        for (size_t i = 0; i < n; ++i) {
+            switch (pattern) {
+                case 0: words[i] = rng(); break;
+                case 1: words[i] = rng() % 5; break;
+                case 2: words[i] = 42; break;
+                case 3: words[i] = i; break;
+                case 4: words[i] = n - i; break;
+                default: words[i] = (rng() & 1) ? UINT64_MAX : 0; break;
+            }
+        }
+        return words;
+    }
+
+    TEST_CASE("Every kernel sorts words and pairs like std::sort") {
+        std::mt19937_64 rng(44);
+        for (vqsort::Isa isa : availableIsas()) {
+            for (size_t n : {0, 1, 7, 25, 100, 1001, 65536 + 3}) {
+                for (int pattern = 0; pattern < 6; ++pattern) {
+                    CAPTURE(vqsort::isaName(isa));
+                    CAPTURE(n);
+                    CAPTURE(pattern);
+                    std::vector<uint64_t> words = makeWords(n, pattern, rng);
+                    std::vector<uint64_t> expected = words;
+                    std::sort(expected.begin(), expected.end());
+                    vqsort::sortWords(words.data(), n, isa);
+                    REQUIRE(words == expected);
+
+                    std::vector<uint64_t> keys = makeWords(n, pattern, rng);
+                    std::vector<uint64_t> values(n);
+                    std::iota(values.begin(), values.end(), 0);
+                    std::vector<std::pair<uint64_t, uint64_t>> pairs(n);
+                    for (size_t i = 0; i < n; ++i) pairs[i] = {keys[i], values[i]};
+                    std::sort(pairs.begin(), pairs.end());
+                    vqsort::sortPairs(keys.data(), values.data(), n, isa);
+                    for (size_t i = 0; i < n; ++i) {
+                        REQUIRE(keys[i] == pairs[i].first);
+                        REQUIRE(values[i] == pairs[i].second);
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename V>
+    void checkKernelsAgree(const std::vector<V>& values) {
+        MyContainer<V> comparison, vectorized, automatic;
+        comparison.setSortKernel(SortKernel::Comparison);
+        vectorized.setSortKernel(SortKernel::Vectorized);
+        CHECK(automatic.sortKernel() == SortKernel::Auto);
+        for (const V& v : values) {
+            comparison.add(v);
+            vectorized.add(v);
+            automatic.add(v);
+        }
+        CHECK(vectorized.sortedIndices() == comparison.sortedIndices());
+        CHECK(automatic.sortedIndices() == comparison.sortedIndices());
+        auto negated = [](V v) { return static_cast<V>(-v); };
+        CHECK(vectorized.descending(negated).getIndices() == comparison.descending(negated).getIndices());
+        CHECK(vectorized.sidecross(negated).getIndices() == comparison.sidecross(negated).getIndices());
+    }
+
+    TEST_CASE("All kernels give the same permutation for every supported key type") {
+        std::mt19937 rng(45);
+        std::vector<int> ints(5000);
+        std::vector<long long> longs(5000);
+        std::vector<unsigned> unsigneds(5000);
+        std::vector<float> floats(5000);
+        std::vector<double> doubles(5000);
+        for (size_t i = 0; i < ints.size(); ++i) {
+            ints[i] = static_cast<int>(rng() % 2001) - 1000;
+            longs[i] = static_cast<long long>(rng()) * (i % 2 ? -1 : 1) * 1000003LL;
+            unsigneds[i] = rng() % 300;
+            floats[i] = static_cast<float>(ints[i]) / 8.0f;
+            doubles[i] = i % 97 == 0 ? -0.0 : static_cast<double>(ints[i]) * 1e-3;
+        }
+        checkKernelsAgree(ints);
+        checkKernelsAgree(longs);
+        checkKernelsAgree(unsigneds);
+        checkKernelsAgree(floats);
+        checkKernelsAgree(doubles);
+    }
+
+    // Ordered by key only, so ties between equal keys are visible through tag
+    struct Tagged {
+        int key;
+        int tag;
+        bool operator<(const Tagged& other) const { return key < other.key; }
+    };
+
+    TEST_CASE("Non-arithmetic elements break ties by position with every kernel") {
+        std::mt19937 rng(44);
+        MyContainer<Tagged> automatic, comparison;
+        comparison.setSortKernel(SortKernel::Comparison);
+        for (int i = 0; i < 2000; ++i) {
+            Tagged t{static_cast<int>(rng() % 10), i};
+            automatic.add(t);
+            comparison.add(t);
+        }
+        std::vector<size_t> expected(2000);
+        std::iota(expected.begin(), expected.end(), 0);
+        std::stable_sort(expected.begin(), expected.end(), [&](size_t a, size_t b) { return automatic[a] < automatic[b]; });
+        CHECK(std::ranges::equal(automatic.sortedIndices(), expected));
+        CHECK(std::ranges::equal(comparison.sortedIndices(), expected));
+    }
+
+    TEST_CASE("Tail sorts after appends use the selected kernel too") {
+        MyContainer<int> container;
+        container.setSortKernel(SortKernel::Vectorized);
+        for (int i = 0; i < 3000; ++i) container.add((i * 7919) % 1000);
+        container.ascending();
+        for (int i = 0; i < 2000; ++i) container.add((i * 104729) % 1000);
+        auto values = extractValues(container.ascending());
+        CHECK(std::is_sorted(values.begin(), values.end()));
+        CHECK(values.size() == 5000);
+    }
+}
+
+//  COUNTING SORT
+TEST_SUITE("Counting Sort") {
+
+    template <typename K, typename Compare>
+    std::vector<size_t> stableOrder(const std::vector<K>& keys, std::vector<size_t> idx, Compare comp) {
+        std::stable_sort(idx.begin(), idx.end(), [&](size_t a, size_t b) { return comp(keys[a], keys[b]); });
+        return idx;
+    }
+
+    template <typename K>
+    void checkCounting(const std::vector<K>& keys) {
+        std::vector<size_t> all(keys.size());
+        std::iota(all.begin(), all.end(), 0);
+        std::vector<size_t> idx = all;
+        REQUIRE(sort_engine::sortCounting(std::span<const K>(keys), idx.begin(), idx.end(), std::less<>(), true));
+        CHECK(idx == stableOrder(keys, all, std::less<>()));
+        idx = all;
+        REQUIRE(sort_engine::sortCounting(std::span<const K>(keys), idx.begin(), idx.end(), std::greater<>(), true));
+        CHECK(idx == stableOrder(keys, all, std::greater<>()));
+
+        // A strided subset of positions (not the whole key column)
+        std::vector<size_t> subset;
+        for (size_t i = 1; i < keys.size(); i += 3) subset.push_back(i);
+        idx = subset;
+        REQUIRE(sort_engine::sortCounting(std::span<const K>(keys), idx.begin(), idx.end(), std::less<>(), true));
+        CHECK(idx == stableOrder(keys, subset, std::less<>()));
+    }
+
+    TEST_CASE("Counting sort matches a stable sort for narrow and small-range keys") {
+        std::mt19937 rng(45);
+        std::vector<uint8_t> bytes(3000);
+        std::vector<int8_t> signed_bytes(3000);
+        std::vector<int16_t> shorts(3000);
+        std::vector<int> ints(3000);
+        std::vector<long long> longs(3000);
+        for (size_t i = 0; i < bytes.size(); ++i) {
+            bytes[i] = static_cast<uint8_t>(rng());
+            signed_bytes[i] = static_cast<int8_t>(rng());
+            shorts[i] = static_cast<int16_t>(rng());
+            ints[i] = 1000000 + static_cast<int>(rng() % 500) - 250;
+            longs[i] = static_cast<long long>(rng() % 100) - (1LL << 40);
+        }
+        checkCounting(bytes);
+        checkCounting(signed_bytes);
+        checkCounting(shorts);
+        checkCounting(ints);
+        checkCounting(longs);
+    }
+
+    TEST_CASE("Counting sort declines ranges that would not pay off") {
+        std::vector<int> wide = {5, -2000000000, 2000000000, 7, 0, 1, 2, 3, 4, 6};
+        std::vector<size_t> idx(wide.size());
+        std::iota(idx.begin(), idx.end(), 0);
+        std::vector<size_t> untouched = idx;
+        CHECK_FALSE(sort_engine::sortCounting(std::span<const int>(wide), idx.begin(), idx.end(), std::less<>(), true));
+        CHECK(idx == untouched);
+
+        std::vector<int> sparse(100);
+        for (size_t i = 0; i < sparse.size(); ++i) sparse[i] = static_cast<int>((i * 37) % 100) * 50;
+        idx.assign(sparse.size(), 0);
+        std::iota(idx.begin(), idx.end(), 0);
+        CHECK_FALSE(sort_engine::sortCounting(std::span<const int>(sparse), idx.begin(), idx.end(), std::less<>(), false));
+        CHECK(sort_engine::sortCounting(std::span<const int>(sparse), idx.begin(), idx.end(), std::less<>(), true));
+        CHECK(std::is_sorted(idx.begin(), idx.end(), [&](size_t a, size_t b) { return sparse[a] < sparse[b]; }));
+
+        std::vector<long long> extremes = {LLONG_MIN, LLONG_MAX, 0};
+        idx = {0, 1, 2};
+        CHECK_FALSE(sort_engine::sortCounting(std::span<const long long>(extremes), idx.begin(), idx.end(), std::less<>(), true));
+
+    }
+
+    TEST_CASE("Counting sort keeps equal keys in input order") {
+        std::vector<uint8_t> small = {3, 1, 3, 1, 2};
+        std::vector<size_t> idx = {4, 2, 0, 3, 1};
+        REQUIRE(sort_engine::sortCounting(std::span<const uint8_t>(small), idx.begin(), idx.end(), std::less<>(), true));
+        CHECK(idx == std::vector<size_t>{3, 1, 4, 2, 0});
+    }
+
+    TEST_CASE("Random keys reach the counting sort after the presorted probe") {
+        std::mt19937 rng(47);
+        std::vector<uint8_t> keys(20000);
+        for (uint8_t& k : keys) k = static_cast<uint8_t>(rng());
+        std::vector<size_t> all(keys.size());
+        std::iota(all.begin(), all.end(), 0);
+        std::vector<size_t> counted = all, compared = all;
+        sort_engine::sortByKeys(keys, counted.begin(), counted.end(), std::less<>(), SortKernel::Counting);
+        sort_engine::sortByKeys(keys, compared.begin(), compared.end(), std::less<>(), SortKernel::Comparison);
+        CHECK(counted == compared);
+        CHECK(counted == stableOrder(keys, all, std::less<>()));
+    }
+
+    TEST_CASE("Counting kernel gives the same orders as the comparison kernel") {
+        std::mt19937 rng(46);
+        MyContainer<uint8_t> counted, compared;
+        counted.setSortKernel(SortKernel::Counting);
+        compared.setSortKernel(SortKernel::Comparison);
+        for (int i = 0; i < 5000; ++i) {
+            uint8_t v = static_cast<uint8_t>(rng());
+            counted.add(v);
+            compared.add(v);
+        }
+        CHECK(counted.sortedIndices() == compared.sortedIndices());
+        CHECK(extractValues(counted.descending()) == extractValues(compared.descending()));
+        CHECK(extractValues(counted.sidecross()) == extractValues(compared.sidecross()));
+
+        MyContainer<int16_t> automatic, reference;
+        reference.setSortKernel(SortKernel::Comparison);
+        for (int i = 0; i < 4000; ++i) {
+            int16_t v = static_cast<int16_t>(static_cast<int>(rng() % 1000) - 500);
+            automatic.add(v);
+            reference.add(v);
+        }
+        CHECK(automatic.ascending().getIndices() == reference.ascending().getIndices());
+        auto square = [](int16_t v) { return static_cast<int>(v) * v; };
+        CHECK(automatic.descending(square).getIndices() == reference.descending(square).getIndices());
+    }
+}
+
+//  MULTIKEY STRING SORT
+TEST_SUITE("String Sort") {
+
+    std::vector<std::string> makeStrings(size_t n, std::mt19937& rng) {
+        const std::vector<std::string> hosts = {"https://example.com/", "https://example.org/api/v1/", "http://a.b/", ""};
+        std::vector<std::string> strings(n);
+        for (size_t i = 0; i < n; ++i) {
+            std::string s = hosts[rng() % hosts.size()];
+            size_t extra = rng() % 24;
+            for (size_t k = 0; k < extra; ++k) {
+                // Small alphabet for many shared prefixes, plus NUL and high bytes
+                const char alphabet[] = {'a', 'b', '/', '\0', '\xff'};
+                s.push_back(alphabet[rng() % 5]);
+            }
+            strings[i] = s;
+        }
+        return strings;
+    }
+
+    template <typename Compare>
+    std::vector<size_t> stableStringOrder(const std::vector<std::string>& keys, Compare comp) {
+        std::vector<size_t> idx(keys.size());
+        std::iota(idx.begin(), idx.end(), 0);
+        std::stable_sort(idx.begin(), idx.end(), [&](size_t a, size_t b) { return comp(keys[a], keys[b]); });
+        return idx;
+    }
+
+    TEST_CASE("Multikey quicksort matches a stable sort, ties by index") {
+        std::mt19937 rng(46);
+        for (size_t n : {0, 1, 5, 17, 300, 20000}) {
+            CAPTURE(n);
+            std::vector<std::string> keys = makeStrings(n, rng);
+            std::vector<size_t> idx(n);
+            std::iota(idx.begin(), idx.end(), 0);
+            mkqsort::sortIndices([&](size_t i) { return std::string_view(keys[i]); }, idx.begin(), idx.end());
+            CHECK(idx == stableStringOrder(keys, std::less<>()));
+
+            std::iota(idx.begin(), idx.end(), 0);
+            sort_engine::sortByKeys(keys, idx.begin(), idx.end(), std::greater<>());
+            CHECK(idx == stableStringOrder(keys, std::greater<>()));
+        }
+    }
+
+    TEST_CASE("Strings that are prefixes of each other or end in NUL bytes") {
+        using namespace std::string_literals;
+        std::vector<std::string> keys = {"abcdefgh"s, "abcdefgh\0"s, "abcdefg"s, "abcdefgh"s, ""s, "\0"s,
+                                         "abcdefghabcdefgh"s, "abcdefghabcdefg\xff"s, "abcdefgh\0\0"s};
+        std::vector<size_t> idx(keys.size());
+        std::iota(idx.begin(), idx.end(), 0);
+        mkqsort::sortIndices([&](size_t i) { return std::string_view(keys[i]); }, idx.begin(), idx.end());
+        CHECK(idx == stableStringOrder(keys, std::less<>()));
+    }
+
+    TEST_CASE("Many long identical strings") {
+        std::vector<std::string> keys(500, std::string(300, 'k'));
+        keys[123] = std::string(300, 'k') + "a";
+        keys[7] = std::string(299, 'k');
+        std::vector<size_t> idx(keys.size());
+        std::iota(idx.begin(), idx.end(), 0);
+        sort_engine::sortByKeys(keys, idx.begin(), idx.end());
+        CHECK(idx == stableStringOrder(keys, std::less<>()));
+    }
+
+    template <typename IteratorType>
+    std::vector<std::string> extractStrings(IteratorType iterator) {
+        std::vector<std::string> result;
+        for (const auto& val : iterator) result.push_back(val);
+        return result;
+    }
+
+    TEST_CASE("Duplicate strings keep index order with either kernel") {
+        std::mt19937 rng(46);
+        MyContainer<std::string> multikey, compared;
+        compared.setSortKernel(SortKernel::Comparison);
+        std::vector<std::string> words;
+        for (int i = 0; i < 3000; ++i) {
+            words.push_back("w" + std::to_string(rng() % 40));
+            multikey.add(words.back());
+            compared.add(words.back());
+        }
+        std::vector<size_t> expected = stableStringOrder(words, std::less<>());
+        CHECK(std::ranges::equal(multikey.sortedIndices(), expected));
+        CHECK(std::ranges::equal(compared.sortedIndices(), expected));
+        CHECK(multikey.descending().getIndices() == compared.descending().getIndices());
+    }
+
+    TEST_CASE("String containers give the same orders with either kernel") {
+        std::mt19937 rng(47);
+        MyContainer<std::string> multikey, compared;
+        compared.setSortKernel(SortKernel::Comparison);
+        for (const std::string& s : makeStrings(3000, rng)) {
+            multikey.add(s);
+            compared.add(s);
+        }
+        CHECK(extractStrings(multikey.ascending()) == extractStrings(compared.ascending()));
+        CHECK(extractStrings(multikey.descending()) == extractStrings(compared.descending()));
+        CHECK(extractStrings(multikey.sidecross()) == extractStrings(compared.sidecross()));
+        auto tail = [](const std::string& s) { return s.size() > 3 ? s.substr(3) : s; };
+        CHECK(multikey.ascending(tail).getIndices() == compared.ascending(tail).getIndices());
+        CHECK(multikey.descending(tail).getIndices() == compared.descending(tail).getIndices());
+        CHECK(std::is_sorted(multikey.sortedIndices().begin(), multikey.sortedIndices().end(), [&](size_t a, size_t b) {
+            return multikey[a] < multikey[b];
+        }));
+    }
+}
+
+//  STRING ARENA CONTAINER
+TEST_SUITE("String Arena Container") {
+
+    std::vector<std::string> collect(Generator<const std::string_view> order) {
+        std::vector<std::string> result;
+        for (std::string_view v : order) result.emplace_back(v);
+        return result;
+    }
+
+    TEST_CASE("All six orders match MyContainer<std::string>") {
+        for (bool intern : {false, true}) {
+            CAPTURE(intern);
+            std::mt19937 rng(47);
+            StringArenaContainer arena(intern);
+            MyContainer<std::string> reference;
+            for (int i = 0; i < 500; ++i) {
+                std::string s = "user:" + std::to_string(rng() % 120);
+                if (i % 50 == 0) s.clear();
+                arena.add(s);
+                reference.add(s);
+            }
+            auto strings = [](auto order) {
+                std::vector<std::string> result;
+                for (const std::string& v : order) result.push_back(v);
+                return result;
+            };
+            CHECK(collect(arena.order()) == strings(reference.order()));
+            CHECK(collect(arena.reverse()) == strings(reference.reverse()));
+            CHECK(collect(arena.middleout()) == strings(reference.middleout()));
+            CHECK(collect(arena.ascending()) == strings(reference.ascending()));
+            CHECK(collect(arena.descending()) == strings(reference.descending()));
+            CHECK(collect(arena.sidecross()) == strings(reference.sidecross()));
+        }
+    }
+
+    TEST_CASE("Random adds and removes agree with MyContainer<std::string>") {
+        for (bool intern : {false, true}) {
+            CAPTURE(intern);
+            std::mt19937 rng(48);
+            StringArenaContainer arena(intern);
+            MyContainer<std::string> reference;
+            for (int step = 0; step < 4000; ++step) {
+                std::string s = "k" + std::to_string(rng() % 400);
+                if (rng() % 4 == 0 && arena.contains(s)) {
+                    arena.remove(s);
+                    reference.remove(s);
+                } else {
+                    arena.add(s);
+                    reference.add(s);
+                }
+                if (step % 500 == 0 && !reference.empty()) {
+                    std::vector<std::string> expected;
+                    for (const std::string& v : reference.ascending()) expected.push_back(v);
+                    REQUIRE(collect(arena.ascending()) == expected);
+                    REQUIRE(arena.sortedIndices() == reference.sortedIndices());
+                }
+            }
+            for (int k = 0; k < 400; ++k) {
+                std::string s = "k" + std::to_string(k);
+                bool present = false;
+                for (size_t i = 0; i < reference.size(); ++i) present = present || reference[i] == s;
+                REQUIRE(arena.contains(s) == present);
+            }
+            CHECK(arena.size() == reference.size());
+        }
+    }
+
+    TEST_CASE("Interned ranks stay right across small tail appends") {
+        std::mt19937 rng(49);
+        StringArenaContainer arena(true);
+        MyContainer<std::string> reference;
+        for (int round = 0; round < 300; ++round) {
+            for (int i = 0; i < 3; ++i) {
+                // Mostly strings seen before, sometimes a new one ranking anywhere
+                std::string s = "s" + std::to_string(rng() % (round % 5 == 0 ? 100000 : 60));
+                arena.add(s);
+                reference.add(s);
+            }
+            if (round == 150) {
+                std::string victim(arena[0]);
+                arena.remove(victim);
+                reference.remove(victim);
+            }
+            REQUIRE(arena.sortedIndices() == reference.sortedIndices());
+        }
+        CHECK(arena.uniqueCount() < arena.size());
+    }
+
+    TEST_CASE("Interning stores each distinct string once") {
+        StringArenaContainer plain, interned(true);
+        for (int i = 0; i < 100; ++i) {
+            plain.add("repeated-value");
+            interned.add("repeated-value");
+        }
+        interned.add("other");
+        CHECK(interned.interning());
+        CHECK(interned.size() == 101);
+        CHECK(interned.uniqueCount() == 2);
+        CHECK(interned.arenaBytes() == std::string_view("repeated-value").size() + 5);
+        CHECK(plain.arenaBytes() == 100 * std::string_view("repeated-value").size());
+        CHECK(interned.handle(0).offset == interned.handle(99).offset);
+        CHECK(interned[100] == "other");
+    }
+
+    TEST_CASE("contains and remove take string views") {
+        for (bool intern : {false, true}) {
+            CAPTURE(intern);
+            StringArenaContainer c(intern);
+            for (const char* s : {"alpha", "beta", "alpha", "gamma", "alph"}) c.add(s);
+            std::string buffer = "xxalphaxx";
+            std::string_view alpha = std::string_view(buffer).substr(2, 5);
+            CHECK(c.contains(alpha));
+            CHECK_FALSE(c.contains("alphab"));
+            c.remove(alpha);
+            CHECK(c.size() == 3);
+            CHECK_FALSE(c.contains("alpha"));
+            CHECK(c.contains("alph"));
+            CHECK_THROWS_AS(c.remove("alpha"), ElementNotFoundException);
+            CHECK(collect(c.ascending()) == std::vector<std::string>{"alph", "beta", "gamma"});
+            CHECK(collect(c.order()) == std::vector<std::string>{"beta", "gamma", "alph"});
+        }
+        StringArenaContainer empty;
+        CHECK_THROWS_AS(empty.remove("x"), ContainerEmptyException);
+        CHECK_THROWS_AS(empty.ascending(), ContainerEmptyException);
+        CHECK_THROWS_AS(empty.at(0), IndexOutOfBoundsException);
+    }
+
+    TEST_CASE("Removal compacts the arena and keeps the sorted permutation") {
+        for (bool intern : {false, true}) {
+            CAPTURE(intern);
+            StringArenaContainer c(intern);
+            c.add("");
+            for (int i = 0; i < 300; ++i) c.add("key-" + std::to_string(i % 30));
+            c.remove("");
+            c.ascending();
+            size_t before = c.arenaBytes();
+            for (int k = 0; k < 20; ++k) c.remove("key-" + std::to_string(k));
+            CHECK(c.size() == 100);
+            CHECK(c.arenaBytes() < before);
+            CHECK(c.garbageBytes() * 2 < c.arenaBytes() + 1);
+            std::vector<std::string> values = collect(c.ascending());
+            CHECK(std::is_sorted(values.begin(), values.end()));
+            CHECK(values.front() == "key-20");
+            for (size_t i = 0; i < c.size(); ++i) {
+                CHECK(c[i] == "key-" + std::to_string(20 + i % 10));
+            }
+            c.add("key-0");
+            CHECK(collect(c.ascending()).front() == "key-0");
+
+            // An empty string shares its offset with the string appended after it
+            StringArenaContainer shared(intern);
+            shared.add("");
+            shared.add("abc");
+            shared.add(std::string(100, 'z'));
+            shared.remove(std::string(100, 'z'));
+            CHECK(shared.garbageBytes() == 0);
+            CHECK(shared[0] == "");
+            CHECK(shared[1] == "abc");
+            c.clear();
+            CHECK(c.empty());
+            CHECK(c.arenaBytes() == 0);
+        }
+    }
+}
+
+namespace {
+    /**
+     * @brief Memory resource that counts what is allocated through it
+     */
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        size_t allocations = 0;
+        size_t outstanding = 0;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            ++allocations;
+            outstanding += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            outstanding -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+}
+
+TEST_SUITE("Memory Resources") {
+    TEST_CASE("Storage and index buffers come from the container's resource") {
+        CountingResource resource;
+        {
+            pmr::MyContainer<int> c(&resource);
+            CHECK(c.get_allocator().resource() == &resource);
+            for (int v : {5, 3, 9, 1, 7, 3}) c.add(v);
+            size_t storage_only = resource.outstanding;
+            CHECK(storage_only > 0);
+
+            auto asc = c.ascending();
+            CHECK(asc.getIndices().get_allocator().resource() == &resource);
+            CHECK(c.sortedIndices().get_allocator().resource() == &resource);
+            CHECK(extractValues(asc) == std::vector<int>{1, 3, 3, 5, 7, 9});
+            CHECK(extractValues(c.descending()) == std::vector<int>{9, 7, 5, 3, 3, 1});
+            CHECK(extractValues(c.sidecross()) == std::vector<int>{1, 9, 3, 7, 3, 5});
+            CHECK(extractValues(c.sidecross([](int v) { return -v; })) == std::vector<int>{9, 1, 7, 3, 5, 3});
+            CHECK(extractValues(c.reverse()) == std::vector<int>{3, 7, 1, 9, 3, 5});
+            CHECK(extractValues(c.order()) == std::vector<int>{5, 3, 9, 1, 7, 3});
+            CHECK(extractValues(c.middleout()) == std::vector<int>{1, 9, 7, 3, 3, 5});
+            CHECK(c.middleout().getIndices().get_allocator().resource() == &resource);
+
+            // Copied orders keep the resource (borrowing an idle pooled buffer here)
+            size_t before = resource.outstanding;
+            {
+                auto copy = asc;
+                CHECK(copy.getIndices().get_allocator().resource() == &resource);
+                CHECK(copy.getIndices() == asc.getIndices());
+            }
+            CHECK(resource.outstanding == before);
+
+            c.remove(3);
+            CHECK(extractValues(c.ascending()) == std::vector<int>{1, 5, 7, 9});
+        }
+        CHECK(resource.outstanding == 0);
+        CHECK(resource.allocations > 0);
+    }
+
+    TEST_CASE("A container and its orders live entirely in a monotonic buffer") {
+        alignas(std::max_align_t) static char buffer[1 << 16];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        pmr::MyContainer<int> c(&arena);
+        for (int i = 0; i < 500; ++i) c.add((i * 37) % 101);
+        std::vector<int> values = extractValues(c.ascending());
+        CHECK(std::is_sorted(values.begin(), values.end()));
+        auto bundle = c.orders();
+        int previous = std::numeric_limits<int>::max();
+        for (int v : bundle.descending()) {
+            CHECK(v <= previous);
+            previous = v;
+        }
+        c.physically_reorder(c.ascending());
+        CHECK(std::is_sorted(c.getT().begin(), c.getT().end()));
+
+        // The upstream is the null resource, so outgrowing the buffer proves nothing used the heap
+        CHECK_THROWS_AS(c.getT().resize(1 << 16), std::bad_alloc);
+    }
+
+    TEST_CASE("Copies use the default resource, moves keep theirs") {
+        std::pmr::monotonic_buffer_resource arena;
+        pmr::MyContainer<std::string> c(2, &arena);
+        c[0] = "pear";
+        c[1] = "apple";
+        c.ascending();
+
+        pmr::MyContainer<std::string> copy = c;
+        CHECK(copy.get_allocator().resource() == std::pmr::get_default_resource());
+        CHECK(copy.sortedIndices() == std::pmr::vector<size_t>{1, 0});
+
+        pmr::MyContainer<std::string> moved = std::move(c);
+        CHECK(moved.get_allocator().resource() == &arena);
+        auto asc = moved.ascending();
+        CHECK(asc.getIndices().get_allocator().resource() == &arena);
+        CHECK(*asc.begin() == "apple");
+    }
+
+    TEST_CASE("Removing from a container in an arena does not grow the arena") {
+        alignas(std::max_align_t) static char buffer[1 << 15];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        pmr::MyContainer<int> c(&arena);
+        c.getT().reserve(1000);
+        for (int i = 0; i < 1000; ++i) c.add((i * 7919) % 1000);
+        c.sortedIndices();
+        // Each remove used to take 8000 bytes of scratch from the 32 KiB buffer
+        for (int v = 0; v < 500; ++v) {
+            c.remove(v);
+            CHECK(c.sortedIndices().size() == c.size());
+        }
+        std::vector<int> values = extractValues(c.ascending());
+        CHECK(values.front() == 500);
+        CHECK(std::is_sorted(values.begin(), values.end()));
+    }
+
+    TEST_CASE("Default containers keep plain std::vector storage and indices") {
+        static_assert(std::is_same_v<decltype(std::declval<MyContainer<int>&>().getT()), std::vector<int>&>);
+        MyContainer<int> c;
+        for (int v : {3, 1, 2}) c.add(v);
+        std::vector<int>& storage = c.getT();
+        auto asc = c.ascending();
+        const std::vector<size_t>& indices = asc.getIndices();
+        CHECK(indices == std::vector<size_t>{1, 2, 0});
+        CHECK(asc.refersTo(storage));
+        std::vector<int> totals(3);
+        inclusive_scan(asc, totals);
+        CHECK(totals == std::vector<int>{1, 3, 6});
+    }
+
+    TEST_CASE("pmr containers work with scans, lazy orders and merges") {
+        std::pmr::monotonic_buffer_resource arena;
+        pmr::MyContainer<int> a(&arena), b(&arena);
+        for (int v : {4, 1}) a.add(v);
+        for (int v : {3, 2}) b.add(v);
+        std::vector<int> totals(2);
+        exclusive_scan(a.ascending(), totals, 10);
+        CHECK(totals == std::vector<int>{10, 11});
+        std::vector<int> lazy_values;
+        for (int v : lazy::descending(a)) lazy_values.push_back(v);
+        CHECK(lazy_values == std::vector<int>{4, 1});
+        std::vector<pmr::MyContainer<int>*> inputs = {&a, &b};
+        CHECK(extractValues(mergedAscending(inputs)) == std::vector<int>{1, 2, 3, 4});
+    }
+}
+
+TEST_SUITE("Index Pool") {
+    TEST_CASE("Re-creating orders reuses index buffers") {
+        CountingResource resource;
+        pmr::MyContainer<int> c(&resource);
+        for (int i = 0; i < 1000; ++i) c.add((i * 7919) % 1000);
+        auto round = [&] {
+            long long total = 0;
+            c.ascending().for_each([&](int v) { total += v; });
+            c.descending().for_each([&](int v) { total += v; });
+            c.sidecross().for_each([&](int v) { total += v; });
+            c.sidecross([](int v) { return -v; }).for_each([&](int v) { total += v; });
+            c.ascending([](int v) { return v % 10; }).for_each([&](int v) { total += v; });
+            c.reverse().for_each([&](int v) { total += v; });
+            c.order().for_each([&](int v) { total += v; });
+            c.middleout().for_each([&](int v) { total += v; });
+            return total;
+        };
+        long long expected = round();
+        size_t warm = resource.allocations;
+        c.enableStats();
+        for (int r = 0; r < 10; ++r) {
+            CHECK(round() == expected);
+        }
+        CHECK(resource.allocations == warm);
+        CHECK(c.stats().index_allocations == 0);
+        CHECK(c.stats().iterator_constructions == 80);
+        CHECK(c.indexPool()->idleBuffers() >= 1);
+    }
+
+    TEST_CASE("Orders alive together get their own buffers") {
+        MyContainer<int> c;
+        for (int v : {4, 8, 1, 6}) c.add(v);
+        {
+            auto asc = c.ascending();
+            auto desc = c.descending();
+            auto copy = asc;
+            auto rev = c.reverse();
+            auto mid = c.middleout();
+            auto cross = c.sidecross();
+            CHECK(extractValues(asc) == std::vector<int>{1, 4, 6, 8});
+            CHECK(extractValues(desc) == std::vector<int>{8, 6, 4, 1});
+            CHECK(extractValues(copy) == std::vector<int>{1, 4, 6, 8});
+            CHECK(extractValues(rev) == std::vector<int>{6, 1, 8, 4});
+            CHECK(extractValues(cross) == std::vector<int>{1, 8, 4, 6});
+            CHECK(mid.getIndices().data() != asc.getIndices().data());
+            CHECK(copy.getIndices().data() != asc.getIndices().data());
+        }
+        CHECK(c.indexPool()->idleBuffers() == IndexPool::MAX_BUFFERS);
+
+        // Buffers borrowed back start empty whatever the previous order held
+        c.remove(8);
+        CHECK(extractValues(c.order()) == std::vector<int>{4, 1, 6});
+        CHECK(extractValues(c.sidecross()) == std::vector<int>{1, 6, 4});
+
+        MyContainer<int> copy = c;
+        CHECK(copy.indexPool() != c.indexPool());
+        c.clear();
+        CHECK(c.indexPool()->idleBuffers() == 0);
+    }
+
+    TEST_CASE("An order can outlive its container's pool") {
+        auto pool_holder = std::make_unique<MyContainer<int>>();
+        pool_holder->add(2);
+        pool_holder->add(1);
+        std::weak_ptr<IndexPool> pool = pool_holder->indexPool();
+        MyContainer<int> moved = std::move(*pool_holder);
+        pool_holder.reset();
+        CHECK(moved.indexPool() == pool.lock());
+        {
+            auto asc = moved.ascending();
+            MyContainer<int> replaced;
+            moved = std::move(replaced);  // drops the container's reference to the pool
+            CHECK_FALSE(pool.expired());  // the live order still returns its buffer into it
+        }
+        CHECK(pool.expired());
+    }
+}
+
+namespace {
+    /**
+     * @brief Element that counts how many instances are alive
+     */
+    struct Tracked {
+        static inline int live = 0;
+        int value;
+        Tracked(int v) : value(v) { ++live; }
+        Tracked(const Tracked& other) : value(other.value) { ++live; }
+        Tracked(Tracked&& other) noexcept : value(other.value) { ++live; }
+        Tracked& operator=(const Tracked&) = default;
+        Tracked& operator=(Tracked&&) noexcept = default;
+        ~Tracked() { --live; }
+        bool operator<(const Tracked& other) const { return value < other.value; }
+        bool operator==(const Tracked& other) const { return value == other.value; }
+        operator int() const { return value; }
+    };
+
+    template <typename C>
+    bool storedInside(const C& c, const void* p) {
+        auto address = reinterpret_cast<const char*>(p);
+        auto self = reinterpret_cast<const char*>(&c);
+        return address >= self && address < self + sizeof(C);
+    }
+}
+
+TEST_SUITE("Small Container") {
+    TEST_CASE("Every order matches MyContainer, inline and spilled") {
+        std::mt19937 rng(50);
+        for (size_t n = 1; n <= 20; ++n) {
+            CAPTURE(n);
+            SmallContainer<int> small;
+            MyContainer<int> reference;
+            for (size_t i = 0; i < n; ++i) {
+                int v = static_cast<int>(rng() % 6);
+                small.add(v);
+                reference.add(v);
+            }
+            CHECK(small.size() == n);
+            CHECK(small.isInline() == (n <= SmallContainer<int>::inline_capacity));
+            CHECK(extractValues(small.order()) == extractValues(reference.order()));
+            CHECK(extractValues(small.reverse()) == extractValues(reference.reverse()));
+            CHECK(extractValues(small.middleout()) == extractValues(reference.middleout()));
+            CHECK(extractValues(small.ascending()) == extractValues(reference.ascending()));
+            CHECK(extractValues(small.descending()) == extractValues(reference.descending()));
+            CHECK(extractValues(small.sidecross()) == extractValues(reference.sidecross()));
+            CHECK(std::ranges::equal(small.sortedIndices(), reference.sortedIndices()));
+            if (small.isInline()) {
+                CHECK(storedInside(small, small.data()));
+                CHECK(storedInside(small, small.sortedIndices().data()));
+            }
+        }
+    }
+
+    TEST_CASE("Appends, writes through a view and removals keep sorted orders right") {
+        SmallContainer<int, 4> c;
+        for (int v : {7, 2, 9}) c.add(v);
+        CHECK(extractValues(c.ascending()) == std::vector<int>{2, 7, 9});
+        c.add(4);
+        CHECK(extractValues(c.ascending()) == std::vector<int>{2, 4, 7, 9});
+        for (int& v : c.order()) v = -v;
+        CHECK(extractValues(c.ascending()) == std::vector<int>{-9, -7, -4, -2});
+
+        c.add(-8);  // spills, keeping the sorted run
+        CHECK_FALSE(c.isInline());
+        c.add(0);
+        CHECK(extractValues(c.ascending()) == std::vector<int>{-9, -8, -7, -4, -2, 0});
+        c.remove(-7);
+        CHECK(extractValues(c.descending()) == std::vector<int>{0, -2, -4, -8, -9});
+        CHECK(c[0] == -2);
+
+        SmallContainer<std::string, 2> words;
+        for (const char* w : {"pear", "fig", "apple", "fig"}) words.add(w);
+        std::vector<std::string> sorted;
+        for (const std::string& w : words.ascending()) sorted.push_back(w);
+        CHECK(sorted == std::vector<std::string>{"apple", "fig", "fig", "pear"});
+        std::ostringstream os;
+        os << words;
+        CHECK(os.str() == "[pear, fig, apple, fig]");
+    }
+
+    TEST_CASE("Adding one of its own elements at capacity copies it before spilling") {
+        SmallContainer<std::string, 2> c;
+        c.add("alpha");
+        c.add("beta");
+        c.add(c[0]);
+        CHECK_FALSE(c.isInline());
+        std::ostringstream os;
+        os << c;
+        CHECK(os.str() == "[alpha, beta, alpha]");
+        c.add(c[1]);
+        CHECK(c[3] == "beta");
+    }
+
+    TEST_CASE("Copies, moves and clear manage element lifetimes") {
+        {
+            SmallContainer<Tracked, 3> inline_c;
+            for (int v : {3, 1, 2}) inline_c.add(Tracked(v));
+            SmallContainer<Tracked, 3> spilled_c;
+            for (int v : {5, 4, 6, 8, 7}) spilled_c.add(Tracked(v));
+            CHECK(Tracked::live == 8);
+
+            SmallContainer<Tracked, 3> copy = spilled_c;
+            CHECK_FALSE(copy.isInline());
+            SmallContainer<Tracked, 3> moved = std::move(inline_c);
+            CHECK(inline_c.empty());
+            CHECK(moved.isInline());
+            CHECK(extractValues(moved.ascending()) == std::vector<int>{1, 2, 3});
+            CHECK(Tracked::live == 13);
+
+            moved = spilled_c;
+            CHECK(extractValues(moved.descending()) == std::vector<int>{8, 7, 6, 5, 4});
+            copy = std::move(moved);
+            CHECK(Tracked::live == 10);
+
+            copy.remove(Tracked(6));
+            CHECK(Tracked::live == 9);
+            copy.clear();
+            CHECK(copy.isInline());
+            CHECK(Tracked::live == 5);
+            copy.add(Tracked(1));
+            CHECK(copy.isInline());
+        }
+        CHECK(Tracked::live == 0);
+    }
+
+    TEST_CASE("Errors match MyContainer") {
+        SmallContainer<int> c;
+        CHECK_THROWS_AS(c.ascending(), ContainerEmptyException);
+        CHECK_THROWS_AS(c.order(), ContainerEmptyException);
+        CHECK_THROWS_AS(c.remove(1), ContainerEmptyException);
+        c.add(1);
+        CHECK_THROWS_AS(c.remove(2), ElementNotFoundException);
+        CHECK_THROWS_AS(c.at(1), IndexOutOfBoundsException);
+        CHECK_THROWS_AS(c[5], IndexOutOfBoundsException);
+    }
+}